@@ -44,6 +44,29 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 #include <xxhash.h> // XXH64.
 #include <QtWidgets/QApplication>
 
+namespace {
+
+// Rows matching the new words match the previous ones as well, if each of
+// the previous words is a prefix of some of the new words.
+[[nodiscard]] bool SearchNarrowed(
+		const QStringList &was,
+		const QStringList &now) {
+	if (was.isEmpty()) {
+		return false;
+	}
+	for (const auto &word : was) {
+		const auto extended = ranges::any_of(now, [&](const QString &w) {
+			return w.startsWith(word);
+		});
+		if (!extended) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
 [[nodiscard]] PeerListRowId UniqueRowIdFromString(const QString &d) {
 	return XXH64(d.data(), d.size() * sizeof(ushort), 0);
 }
@@ -1346,6 +1369,7 @@ void PeerListContent::addToSearchIndex(not_null<PeerListRow*> row) {
 	}
 
 	removeFromSearchIndex(row);
+	_localSearchWords.clear();
 	row->setNameFirstLetters(row->generateNameFirstLetters());
 	for (auto ch : row->nameFirstLetters()) {
 		_searchIndex[ch].push_back(row);
@@ -1366,6 +1390,7 @@ void PeerListContent::removeFromSearchIndex(not_null<PeerListRow*> row) {
 			}
 		}
 		row->setNameFirstLetters({});
+		_localSearchWords.clear();
 	}
 }
 
@@ -1488,6 +1513,8 @@ void PeerListContent::clearAllContent() {
 	_rowsByPeer.clear();
 	_filterResults.clear();
 	_searchIndex.clear();
+	_localSearchWords.clear();
+	_localSearchResults.clear();
 	_rows.clear();
 	_searchRows.clear();
 	_searchQuery
@@ -2424,18 +2451,25 @@ void PeerListContent::searchQueryChanged(QString query) {
 		if (_controller->searchInLocal() && !searchWordsList.isEmpty()) {
 			Assert(_hiddenRows.empty() || _ignoreHiddenRowsOnSearch);
 
+			// While the query is being typed each new result is a subset
+			// of the previous one, so only the previous results are checked.
 			auto minimalList = (const std::vector<not_null<PeerListRow*>>*)nullptr;
-			for (const auto &searchWord : searchWordsList) {
-				auto searchWordStart = searchWord[0].toLower();
-				auto it = _searchIndex.find(searchWordStart);
-				if (it == _searchIndex.cend()) {
-					// Some word can't be found in any row.
-					minimalList = nullptr;
-					break;
-				} else if (!minimalList || minimalList->size() > it->second.size()) {
-					minimalList = &it->second;
+			if (SearchNarrowed(_localSearchWords, searchWordsList)) {
+				minimalList = &_localSearchResults;
+			} else {
+				for (const auto &searchWord : searchWordsList) {
+					auto searchWordStart = searchWord[0].toLower();
+					auto it = _searchIndex.find(searchWordStart);
+					if (it == _searchIndex.cend()) {
+						// Some word can't be found in any row.
+						minimalList = nullptr;
+						break;
+					} else if (!minimalList || minimalList->size() > it->second.size()) {
+						minimalList = &it->second;
+					}
 				}
 			}
+			auto found = std::vector<not_null<PeerListRow*>>();
 			if (minimalList) {
 				auto searchWordInNames = [](
 						not_null<PeerListRow*> row,
@@ -2457,13 +2491,19 @@ void PeerListContent::searchQueryChanged(QString query) {
 					return true;
 				};
 
-				_filterResults.reserve(minimalList->size());
+				found.reserve(minimalList->size());
 				for (const auto &row : *minimalList) {
 					if (allSearchWordsInNames(row)) {
-						_filterResults.push_back(row);
+						found.push_back(row);
 					}
 				}
 			}
+			_filterResults.insert(
+				end(_filterResults),
+				begin(found),
+				end(found));
+			_localSearchWords = searchWordsList;
+			_localSearchResults = std::move(found);
 		}
 		if (_controller->hasComplexSearch()) {
 			_controller->search(_searchQuery);
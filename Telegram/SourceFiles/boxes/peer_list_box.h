@@ -775,6 +775,7 @@ public:
 		for (auto &searchEntity : _searchIndex) {
 			callback(searchEntity.second.begin(), searchEntity.second.end());
 		}
+		_localSearchWords.clear();
 		refreshIndices();
 		if (!_hiddenRows.empty()) {
 			callback(_filterResults.begin(), _filterResults.end());
@@ -958,6 +959,8 @@ private:
 	std::map<PeerData*, std::vector<not_null<PeerListRow*>>> _rowsByPeer;
 
 	std::map<QChar, std::vector<not_null<PeerListRow*>>> _searchIndex;
+	QStringList _localSearchWords;
+	std::vector<not_null<PeerListRow*>> _localSearchResults;
 	QString _searchQuery;
 	QString _normalizedSearchQuery;
 	QString _mentionHighlight;
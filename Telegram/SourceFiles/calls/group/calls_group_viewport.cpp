@@ -281,6 +281,22 @@ void Viewport::updateMyWidgetPart() {
 	}
 }
 
+void Viewport::updateTilePart(const VideoEndpoint &endpoint) {
+	const auto i = ranges::find_if(_tiles, [&](const auto &tile) {
+		return (tile->endpoint() == endpoint);
+	});
+	if (i == end(_tiles)) {
+		updateMyWidgetPart();
+		return;
+	}
+	const auto geometry = (*i)->geometry().translated(borrowedOrigin());
+	if (!_borrowed) {
+		widget()->update(geometry);
+	} else if (!_borrowedGeometry.isEmpty()) {
+		widget()->update(geometry.intersected(_borrowedGeometry));
+	}
+}
+
 void Viewport::setCursorShown(bool shown) {
 	if (_cursorHidden == shown) {
 		_cursorHidden = !shown;
@@ -299,7 +315,7 @@ void Viewport::add(
 		track,
 		std::move(trackSize),
 		std::move(pinned),
-		[=] { updateMyWidgetPart(); },
+		[=] { updateTilePart(endpoint); },
 		self));
 
 	_tiles.back()->trackSizeValue(
@@ -204,6 +204,7 @@ private:
 		Ui::GL::Backend backend);
 	[[nodiscard]] std::unique_ptr<Ui::GL::Renderer> makeRenderer();
 	void updateMyWidgetPart();
+	void updateTilePart(const VideoEndpoint &endpoint);
 
 	PanelMode _mode = PanelMode();
 	bool _opengl = false;
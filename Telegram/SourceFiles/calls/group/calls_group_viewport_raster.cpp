@@ -23,6 +23,7 @@ namespace Calls::Group {
 namespace {
 
 constexpr auto kBlurRadius = 15;
+constexpr auto kFrameStatsInterval = 300;
 
 } // namespace
 
@@ -46,11 +47,32 @@ void Viewport::RendererSW::paintFallback(
 	for (auto &[tile, tileData] : _tileData) {
 		tileData.stale = true;
 	}
+	for (const auto &tile : _owner->_tiles) {
+		if (tile->visible()) {
+			_tileData[tile.get()].stale = false;
+		}
+	}
+
+	// All insertions are done, so TilePaint::data pointers stay valid.
+	auto tiles = std::vector<TilePaint>();
 	for (const auto &tile : _owner->_tiles) {
 		if (!tile->visible()) {
 			continue;
 		}
-		paintTile(p, tile.get(), bounding, bg);
+
+		// Tiles without new frames are outside of the updated region.
+		const auto geometry = tile->geometry().translated(
+			_owner->borrowedOrigin());
+		if (geometry.intersects(bounding)) {
+			auto &tileData = _tileData[tile.get()];
+			tiles.push_back(prepareTile(tile.get(), tileData, geometry));
+		}
+	}
+	prepareTileFrames(tiles);
+	for (const auto &tile : tiles) {
+		const auto started = crl::now();
+		paintTile(p, tile, bounding, bg);
+		accumulateFrameStats(tile, tile.time + (crl::now() - started));
 	}
 	if (_owner->borrowedOrigin().isNull()) {
 		const auto fullscreen = _owner->_fullscreen;
@@ -89,37 +111,140 @@ void Viewport::RendererSW::validateUserpicFrame(
 		kBlurRadius);
 }
 
-void Viewport::RendererSW::paintTile(
-		Painter &p,
+auto Viewport::RendererSW::prepareTile(
 		not_null<VideoTile*> tile,
-		const QRect &clip,
-		QRegion &bg) {
+		TileData &data,
+		QRect geometry)
+-> TilePaint {
 	const auto track = tile->track();
-	const auto markGuard = gsl::finally([&] {
-		tile->track()->markFrameShown();
-	});
-	const auto data = track->frameWithInfo(true);
-	auto &tileData = _tileData[tile];
-	tileData.stale = false;
-	_userpicFrame = (data.format == Webrtc::FrameFormat::None);
+	const auto frame = track->frameWithInfo(true);
+	_userpicFrame = (frame.format == Webrtc::FrameFormat::None);
 	_pausedFrame = (track->state() == Webrtc::VideoState::Paused);
-	validateUserpicFrame(tile, tileData);
+	validateUserpicFrame(tile, data);
 	if (_userpicFrame || !_pausedFrame) {
-		tileData.blurredFrame = QImage();
-	} else if (tileData.blurredFrame.isNull()) {
-		tileData.blurredFrame = Images::BlurLargeImage(
-			data.original.scaled(
+		data.blurredFrame = QImage();
+		data.blurredIndex = -1;
+	}
+	auto result = TilePaint{
+		.tile = tile,
+		.data = &data,
+		.geometry = geometry,
+		.userpic = _userpicFrame,
+		.paused = _pausedFrame,
+		.index = _userpicFrame ? 0 : (frame.index + 1),
+		.rotation = _userpicFrame ? 0 : frame.rotation,
+		.mirror = tile->mirror(),
+	};
+	const auto &original = _userpicFrame
+		? data.userpicFrame
+		: frame.original;
+	Assert(!original.isNull());
+
+	using namespace Media::View;
+	const auto scaled = FlipSizeByRotation(
+		original.size(),
+		result.rotation
+	).scaled(geometry.size(), Qt::KeepAspectRatio);
+	result.target = QRect(
+		geometry.topLeft() + QPoint(
+			(geometry.width() - scaled.width()) / 2,
+			(geometry.height() - scaled.height()) / 2),
+		scaled);
+	result.size = scaled * style::DevicePixelRatio();
+	if (data.preparedIndex == result.index
+		&& data.preparedSize == result.size
+		&& data.preparedPaused == result.paused
+		&& data.preparedMirror == result.mirror
+		&& !data.prepared.isNull()) {
+		return result;
+	}
+	result.dirty = true;
+	if (_pausedFrame && !_userpicFrame) {
+		// The blurred background is kept until the paused frame changes.
+		result.blur = data.blurredFrame.isNull()
+			|| (data.blurredIndex != result.index)
+			|| (data.preparedMirror != result.mirror);
+		result.source = result.blur ? frame.original : data.blurredFrame;
+	} else {
+		result.source = original;
+	}
+	return result;
+}
+
+void Viewport::RendererSW::prepareTileFrames(std::vector<TilePaint> &tiles) {
+	auto jobs = std::vector<not_null<TilePaint*>>();
+	for (auto &tile : tiles) {
+		if (tile.dirty) {
+			jobs.push_back(&tile);
+		}
+	}
+	if (jobs.empty()) {
+		return;
+	}
+	const auto count = int(jobs.size());
+	const auto waiters = std::make_unique<crl::semaphore[]>(count);
+	for (auto i = 1; i != count; ++i) {
+		crl::async([job = jobs[i], waiter = &waiters[i]] {
+			PrepareTileFrame(*job);
+			waiter->release();
+		});
+	}
+	PrepareTileFrame(*jobs.front());
+	for (auto i = 1; i != count; ++i) {
+		waiters[i].acquire();
+	}
+
+	const auto ratio = style::DevicePixelRatio();
+	for (const auto job : jobs) {
+		auto &data = *job->data;
+		if (job->blur) {
+			data.blurredFrame = base::take(job->source);
+			data.blurredIndex = job->index;
+		}
+		data.prepared = base::take(job->prepared);
+		data.prepared.setDevicePixelRatio(ratio);
+		data.preparedSize = job->size;
+		data.preparedIndex = job->index;
+		data.preparedPaused = job->paused;
+		data.preparedMirror = job->mirror;
+	}
+}
+
+void Viewport::RendererSW::PrepareTileFrame(TilePaint &tile) {
+	const auto started = crl::now();
+	auto image = tile.source;
+	if (tile.blur) {
+		image = Images::BlurLargeImage(
+			image.scaled(
 				VideoTile::PausedVideoSize(),
-				Qt::KeepAspectRatio).mirrored(tile->mirror(), false),
+				Qt::KeepAspectRatio).mirrored(tile.mirror, false),
 			kBlurRadius);
+		tile.source = image;
+	} else if (!tile.userpic && !tile.paused && tile.mirror) {
+		image = image.mirrored(true, false);
 	}
-	const auto &image = _userpicFrame
-		? tileData.userpicFrame
-		: _pausedFrame
-		? tileData.blurredFrame
-		: data.original.mirrored(tile->mirror(), false);
-	const auto frameRotation = _userpicFrame ? 0 : data.rotation;
-	Assert(!image.isNull());
+	if (tile.rotation) {
+		image = Media::View::RotateFrameImage(
+			std::move(image),
+			tile.rotation);
+	}
+	tile.prepared = image.scaled(
+		tile.size,
+		Qt::IgnoreAspectRatio,
+		Qt::SmoothTransformation);
+	tile.time = crl::now() - started;
+}
+
+void Viewport::RendererSW::paintTile(
+		Painter &p,
+		const TilePaint &tile,
+		const QRect &clip,
+		QRegion &bg) {
+	const auto markGuard = gsl::finally([&] {
+		tile.tile->track()->markFrameShown();
+	});
+	_userpicFrame = tile.userpic;
+	_pausedFrame = tile.paused;
 
 	const auto background = _owner->_fullscreen
 		? QColor(0, 0, 0)
@@ -132,51 +257,48 @@ void Viewport::RendererSW::paintTile(
 		}
 	};
 
-	using namespace Media::View;
-	const auto geometry = tile->geometry().translated(
-		_owner->borrowedOrigin());
-	const auto x = geometry.x();
-	const auto y = geometry.y();
-	const auto width = geometry.width();
-	const auto height = geometry.height();
-	const auto scaled = FlipSizeByRotation(
-		image.size(),
-		frameRotation
-	).scaled(QSize(width, height), Qt::KeepAspectRatio);
-	const auto left = (width - scaled.width()) / 2;
-	const auto top = (height - scaled.height()) / 2;
-	const auto target = QRect(QPoint(x + left, y + top), scaled);
-	if (UsePainterRotation(frameRotation)) {
-		if (frameRotation) {
-			p.save();
-			p.rotate(frameRotation);
-		}
-		p.drawImage(RotatedRect(target, frameRotation), image);
-		if (frameRotation) {
-			p.restore();
-		}
-	} else if (frameRotation) {
-		p.drawImage(target, RotateFrameImage(image, frameRotation));
-	} else {
-		p.drawImage(target, image);
-	}
+	const auto &target = tile.target;
+	p.drawImage(target.topLeft(), tile.data->prepared);
 	bg -= target;
 
+	const auto x = tile.geometry.x();
+	const auto y = tile.geometry.y();
+	const auto width = tile.geometry.width();
+	const auto height = tile.geometry.height();
+	const auto left = target.x() - x;
+	const auto top = target.y() - y;
 	if (left > 0) {
 		fill({ x, y, left, height });
 	}
-	if (const auto right = left + scaled.width(); right < width) {
+	if (const auto right = left + target.width(); right < width) {
 		fill({ x + right, y, width - right, height });
 	}
 	if (top > 0) {
 		fill({ x, y, width, top });
 	}
-	if (const auto bottom = top + scaled.height(); bottom < height) {
+	if (const auto bottom = top + target.height(); bottom < height) {
 		fill({ x, y + bottom, width, height - bottom });
 	}
 
-	paintTileControls(p, x, y, width, height, tile);
-	paintTileOutline(p, x, y, width, height, tile);
+	paintTileControls(p, x, y, width, height, tile.tile);
+	paintTileOutline(p, x, y, width, height, tile.tile);
+}
+
+void Viewport::RendererSW::accumulateFrameStats(
+		const TilePaint &tile,
+		crl::time time) {
+	auto &stats = tile.data->stats;
+	++stats.frames;
+	stats.total += time;
+	stats.maximum = std::max(stats.maximum, time);
+	if (stats.frames < kFrameStatsInterval) {
+		return;
+	}
+	DEBUG_LOG(("Group Call SW: tile %1 frame time avg %2ms, max %3ms."
+		).arg(QString::fromStdString(tile.tile->endpoint().id)
+		).arg(stats.total / float64(stats.frames), 0, 'f', 2
+		).arg(stats.maximum));
+	stats = FrameStats();
 }
 
 void Viewport::RendererSW::paintTileOutline(
@@ -25,14 +25,52 @@ public:
 		Ui::GL::Backend backend) override;
 
 private:
+	struct FrameStats {
+		int frames = 0;
+		crl::time total = 0;
+		crl::time maximum = 0;
+	};
 	struct TileData {
 		QImage userpicFrame;
 		QImage blurredFrame;
+		QImage prepared;
+		QSize preparedSize;
+		int blurredIndex = -1;
+		int preparedIndex = -1;
+		bool preparedPaused = false;
+		bool preparedMirror = false;
+		FrameStats stats;
 		bool stale = false;
 	};
+	struct TilePaint {
+		not_null<VideoTile*> tile;
+		not_null<TileData*> data;
+		QRect geometry;
+		QRect target;
+		bool userpic = false;
+		bool paused = false;
+
+		// Input and output of the frame preparation on a worker thread.
+		QImage source;
+		QSize size;
+		int index = 0;
+		int rotation = 0;
+		bool mirror = false;
+		bool blur = false;
+		bool dirty = false;
+		QImage prepared;
+		crl::time time = 0;
+	};
+
+	[[nodiscard]] TilePaint prepareTile(
+		not_null<VideoTile*> tile,
+		TileData &data,
+		QRect geometry);
+	void prepareTileFrames(std::vector<TilePaint> &tiles);
+	static void PrepareTileFrame(TilePaint &tile);
 	void paintTile(
 		Painter &p,
-		not_null<VideoTile*> tile,
+		const TilePaint &tile,
 		const QRect &clip,
 		QRegion &bg);
 	void paintTileOutline(
@@ -52,6 +90,7 @@ private:
 	void validateUserpicFrame(
 		not_null<VideoTile*> tile,
 		TileData &data);
+	void accumulateFrameStats(const TilePaint &tile, crl::time time);
 
 	const not_null<Viewport*> _owner;
 
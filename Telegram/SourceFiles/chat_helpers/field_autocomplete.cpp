@@ -70,18 +70,6 @@ constexpr auto kEphemeralHintHoverDelay = crl::time(500);
 	return usernames.empty() ? user->username() : usernames.front();
 }
 
-template <typename T, typename U>
-inline int indexOfInFirstN(const T &v, const U &elem, int last) {
-	for (auto b = v.cbegin(), i = b, e = b + std::min(int(v.size()), last)
-		; i != e
-		; ++i) {
-		if (i->user == elem) {
-			return (i - b);
-		}
-	}
-	return -1;
-}
-
 } // namespace
 
 class FieldAutocomplete::Inner final : public Ui::RpWidget {
@@ -501,6 +489,17 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 			mrows.reserve(maxListSize);
 		}
 
+		const auto filterPeer = _chat
+			? static_cast<PeerData*>(_chat)
+			: static_cast<PeerData*>(_channel);
+		const auto narrowed = !_filter.isEmpty()
+			&& (_mentionFilterCache.peer == filterPeer)
+			&& !_mentionFilterCache.filter.isEmpty()
+			&& _filter.startsWith(
+				_mentionFilterCache.filter,
+				Qt::CaseInsensitive);
+		auto matched = std::unordered_map<UserData*, bool>();
+
 		auto filterNotPassedByUsername = [this](UserData *user) -> bool {
 			if (PrimaryUsername(user).startsWith(_filter, Qt::CaseInsensitive)) {
 				const auto exactUsername
@@ -510,18 +509,36 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 			return true;
 		};
 		auto filterNotPassedByName = [&](UserData *user) -> bool {
-			for (const auto &nameWord : user->nameWords()) {
-				if (nameWord.startsWith(_filter, Qt::CaseInsensitive)) {
-					const auto exactUsername = PrimaryUsername(user).compare(
-						_filter,
-						Qt::CaseInsensitive) == 0;
-					return exactUsername;
+			if (narrowed) {
+				const auto i = _mentionFilterCache.matched.find(user);
+				if (i != end(_mentionFilterCache.matched) && !i->second) {
+					matched.emplace(user, false);
+					return true;
 				}
 			}
-			return filterNotPassedByUsername(user);
+			const auto username = PrimaryUsername(user);
+			auto matches = username.startsWith(_filter, Qt::CaseInsensitive);
+			if (!matches) {
+				for (const auto &nameWord : user->nameWords()) {
+					if (nameWord.startsWith(_filter, Qt::CaseInsensitive)) {
+						matches = true;
+						break;
+					}
+				}
+			}
+			matched.emplace(user, matches);
+			if (!matches) {
+				return true;
+			}
+			const auto exactUsername = username.compare(
+				_filter,
+				Qt::CaseInsensitive) == 0;
+			return exactUsername;
 		};
+		auto rowIndices = std::unordered_map<UserData*, int>();
 		const auto mentionUserIndex = [&](not_null<UserData*> user) {
-			return indexOfInFirstN(mrows, user, int(mrows.size()));
+			const auto i = rowIndices.find(user);
+			return (i != end(rowIndices)) ? i->second : -1;
 		};
 		const auto containsMentionUser = [&](not_null<UserData*> user) {
 			return mentionUserIndex(user) >= 0;
@@ -532,6 +549,7 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 			if (containsMentionUser(user)) {
 				return;
 			}
+			rowIndices.emplace(user, int(mrows.size()));
 			mrows.push_back({
 				.user = user,
 				.source = source,
@@ -629,6 +647,11 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 				}
 			}
 		}
+		_mentionFilterCache = {
+			.peer = filterPeer,
+			.filter = _filter,
+			.matched = std::move(matched),
+		};
 	} else if (_type == Type::Hashtags) {
 		bool listAllSuggestions = _filter.isEmpty();
 		auto &recent(cRecentWriteHashtags());
@@ -162,6 +162,14 @@ private:
 	using StickerRows = std::vector<StickerSuggestion>;
 	using MentionRows = std::vector<MentionRow>;
 
+	// Members matching the filter prefix by name or username, so that
+	// typing more letters checks only the previously matched ones.
+	struct MentionFilterCache {
+		PeerData *peer = nullptr;
+		QString filter;
+		std::unordered_map<UserData*, bool> matched;
+	};
+
 	void animationCallback();
 	void hideFinish();
 
@@ -178,6 +186,7 @@ private:
 	const style::EmojiPan &_st;
 	QPixmap _cache;
 	MentionRows _mrows;
+	MentionFilterCache _mentionFilterCache;
 	HashtagRows _hrows;
 	BotCommandRows _brows;
 	StickerRows _srows;
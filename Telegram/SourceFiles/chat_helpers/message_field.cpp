@@ -41,6 +41,7 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 #include "data/data_document.h"
 #include "data/stickers/data_custom_emoji.h"
 #include "chat_helpers/emoji_suggestions_widget.h"
+#include "chat_helpers/spellchecker_common.h"
 #include "history/view/controls/compose_controls_common.h"
 #include "window/window_session_controller.h"
 #include "lang/lang_keys.h"
@@ -74,6 +75,7 @@ using EditLinkAction = Ui::InputField::EditLinkAction;
 using EditLinkSelection = Ui::InputField::EditLinkSelection;
 
 constexpr auto kParseLinksTimeout = crl::time(1000);
+constexpr auto kParseLinksAsyncLength = 4096;
 constexpr auto kTypesDuration = 4 * crl::time(1000);
 constexpr auto kCodeLanguageLimit = 32;
 
@@ -371,6 +373,84 @@ TextWithEntities StripSupportHashtag(TextWithEntities text) {
 	return text;
 }
 
+// Links never contain line breaks, so each paragraph can be scanned
+// on its own. Returns ranges in the whole text coordinates.
+[[nodiscard]] std::vector<MessageLinkRange> FindLinkRanges(
+		const QString &full,
+		int from,
+		int till) {
+	const auto text = full.mid(from, till - from);
+	auto result = std::vector<MessageLinkRange>();
+	const auto len = text.size();
+	const QChar *start = text.unicode(), *end = start + text.size();
+	for (auto offset = 0, matchOffset = offset; offset < len;) {
+		auto m = qthelp::RegExpDomain().match(text, matchOffset);
+		if (!m.hasMatch()) break;
+
+		auto domainOffset = m.capturedStart();
+
+		auto protocol = m.captured(1).toLower();
+		auto topDomain = m.captured(3).toLower();
+		auto isProtocolValid = protocol.isEmpty() || TextUtilities::IsValidProtocol(protocol);
+		auto isTopDomainValid = !protocol.isEmpty() || TextUtilities::IsValidTopDomain(topDomain);
+
+		if (protocol.isEmpty() && domainOffset > offset + 1 && *(start + domainOffset - 1) == QChar('@')) {
+			auto forMailName = text.mid(offset, domainOffset - offset - 1);
+			auto mMailName = TextUtilities::RegExpMailNameAtEnd().match(forMailName);
+			if (mMailName.hasMatch()) {
+				offset = matchOffset = m.capturedEnd();
+				continue;
+			}
+		}
+		if (!isProtocolValid || !isTopDomainValid) {
+			offset = matchOffset = m.capturedEnd();
+			continue;
+		}
+
+		QStack<const QChar*> parenth;
+		const QChar *domainEnd = start + m.capturedEnd(), *p = domainEnd;
+		for (; p < end; ++p) {
+			QChar ch(*p);
+			if (IsLinkEnd(ch)) {
+				break; // link finished
+			} else if (IsAlmostLinkEnd(ch)) {
+				const QChar *endTest = p + 1;
+				while (endTest < end && IsAlmostLinkEnd(*endTest)) {
+					++endTest;
+				}
+				if (endTest >= end || IsLinkEnd(*endTest)) {
+					break; // link finished at p
+				}
+				p = endTest;
+				ch = *p;
+			}
+			if (ch == '(' || ch == '[' || ch == '{' || ch == '<') {
+				parenth.push(p);
+			} else if (ch == ')' || ch == ']' || ch == '}' || ch == '>') {
+				if (parenth.isEmpty()) break;
+				const QChar *q = parenth.pop(), open(*q);
+				if ((ch == ')' && open != '(') || (ch == ']' && open != '[') || (ch == '}' && open != '{') || (ch == '>' && open != '<')) {
+					p = q;
+					break;
+				}
+			}
+		}
+		if (p > domainEnd) { // check, that domain ended
+			if (domainEnd->unicode() != '/' && domainEnd->unicode() != '?') {
+				matchOffset = domainEnd - start;
+				continue;
+			}
+		}
+		result.push_back({
+			from + int(domainOffset),
+			static_cast<int>(p - start - domainOffset),
+			QString()
+		});
+		offset = matchOffset = p - start;
+	}
+	return result;
+}
+
 } // namespace
 
 QString PrepareMentionTag(not_null<UserData*> user) {
@@ -751,6 +831,7 @@ void InitSpellchecker(
 		field.get(),
 		Core::App().settings().spellcheckerEnabledValue(),
 		menuItem);
+	WatchFieldLanguage(field);
 #endif // TDESKTOP_DISABLE_SPELLCHECK
 }
 
@@ -1003,7 +1084,7 @@ AutocompleteQuery ParseMentionHashtagBotCommandQuery(
 
 MessageLinksParser::MessageLinksParser(not_null<Ui::InputField*> field)
 : _field(field)
-, _timer([=] { parse(); }) {
+, _timer([=] { parse(true); }) {
 	_lifetime = _field->changes(
 	) | rpl::on_next([=] {
 		const auto length = _field->getTextWithTags().text.size();
@@ -1050,16 +1131,99 @@ bool MessageLinksParser::eventFilter(QObject *object, QEvent *event) {
 	return QObject::eventFilter(object, event);
 }
 
-void MessageLinksParser::parse() {
-	const auto &textWithTags = _field->getTextWithTags();
-	const auto &text = textWithTags.text;
-	const auto &tags = textWithTags.tags;
-	const auto &markdownTags = _field->getMarkdownTags();
+void MessageLinksParser::parse(bool allowAsync) {
+	const auto &text = _field->getTextWithTags().text;
 	if (_disabled || text.isEmpty()) {
+		++_scanRequestId;
+		_scannedText = QString();
+		_scannedRanges.clear();
 		_ranges = {};
 		_list = QStringList();
 		return;
+	} else if (scan(text, allowAsync)) {
+		applyTags();
+	}
+}
+
+bool MessageLinksParser::scan(const QString &text, bool allowAsync) {
+	++_scanRequestId;
+
+	const auto &was = _scannedText;
+	const auto wasLength = int(was.size());
+	const auto nowLength = int(text.size());
+	const auto limit = std::min(wasLength, nowLength);
+	auto prefix = 0;
+	while (prefix < limit && was[prefix] == text[prefix]) {
+		++prefix;
+	}
+	if (prefix == wasLength && prefix == nowLength) {
+		return true;
+	}
+	auto suffix = 0;
+	while (suffix < limit - prefix
+		&& (was[wasLength - suffix - 1] == text[nowLength - suffix - 1])) {
+		++suffix;
+	}
+
+	// Rescan only the paragraphs touched by the edit.
+	const auto from = prefix
+		? int(text.lastIndexOf(QChar('\n'), prefix - 1)) + 1
+		: 0;
+	const auto newline = text.indexOf(QChar('\n'), nowLength - suffix);
+	const auto till = (newline < 0) ? nowLength : int(newline);
+	if (!allowAsync || (till - from) < kParseLinksAsyncLength) {
+		updateScanned(text, from, till, FindLinkRanges(text, from, till));
+		return true;
+	}
+	const auto requestId = _scanRequestId;
+	crl::async([=] {
+		auto found = FindLinkRanges(text, from, till);
+		crl::on_main(this, [=, found = std::move(found)]() mutable {
+			if (_scanRequestId != requestId) {
+				return;
+			}
+			updateScanned(text, from, till, std::move(found));
+			if (_field->getTextWithTags().text == text) {
+				applyTags();
+			}
+		});
+	});
+	return false;
+}
+
+void MessageLinksParser::updateScanned(
+		const QString &text,
+		int from,
+		int till,
+		std::vector<MessageLinkRange> &&found) {
+	const auto delta = int(text.size()) - int(_scannedText.size());
+	const auto wasTill = till - delta;
+	auto ranges = std::vector<MessageLinkRange>();
+	ranges.reserve(_scannedRanges.size() + found.size());
+	auto i = begin(_scannedRanges);
+	const auto e = end(_scannedRanges);
+	for (; i != e && i->start + i->length <= from; ++i) {
+		ranges.push_back(std::move(*i));
+	}
+	ranges.insert(
+		end(ranges),
+		std::make_move_iterator(begin(found)),
+		std::make_move_iterator(end(found)));
+	for (; i != e; ++i) {
+		if (i->start >= wasTill) {
+			i->start += delta;
+			ranges.push_back(std::move(*i));
+		}
 	}
+	_scannedText = text;
+	_scannedRanges = std::move(ranges);
+}
+
+void MessageLinksParser::applyTags() {
+	const auto &textWithTags = _field->getTextWithTags();
+	const auto &text = textWithTags.text;
+	const auto &tags = textWithTags.tags;
+	const auto &markdownTags = _field->getMarkdownTags();
 	const auto tagCanIntersectWithLink = [](const QString &tag) {
 		return (tag == Ui::InputField::kTagBold)
 			|| (tag == Ui::InputField::kTagItalic)
@@ -1121,78 +1285,13 @@ void MessageLinksParser::parse() {
 				+ markdownTag->adjustedLength < from + length);
 	};
 
-	const auto len = text.size();
-	const QChar *start = text.unicode(), *end = start + text.size();
-	for (auto offset = 0, matchOffset = offset; offset < len;) {
-		auto m = qthelp::RegExpDomain().match(text, matchOffset);
-		if (!m.hasMatch()) break;
-
-		auto domainOffset = m.capturedStart();
-
-		auto protocol = m.captured(1).toLower();
-		auto topDomain = m.captured(3).toLower();
-		auto isProtocolValid = protocol.isEmpty() || TextUtilities::IsValidProtocol(protocol);
-		auto isTopDomainValid = !protocol.isEmpty() || TextUtilities::IsValidTopDomain(topDomain);
-
-		if (protocol.isEmpty() && domainOffset > offset + 1 && *(start + domainOffset - 1) == QChar('@')) {
-			auto forMailName = text.mid(offset, domainOffset - offset - 1);
-			auto mMailName = TextUtilities::RegExpMailNameAtEnd().match(forMailName);
-			if (mMailName.hasMatch()) {
-				offset = matchOffset = m.capturedEnd();
-				continue;
-			}
-		}
-		if (!isProtocolValid || !isTopDomainValid) {
-			offset = matchOffset = m.capturedEnd();
-			continue;
-		}
-
-		QStack<const QChar*> parenth;
-		const QChar *domainEnd = start + m.capturedEnd(), *p = domainEnd;
-		for (; p < end; ++p) {
-			QChar ch(*p);
-			if (IsLinkEnd(ch)) {
-				break; // link finished
-			} else if (IsAlmostLinkEnd(ch)) {
-				const QChar *endTest = p + 1;
-				while (endTest < end && IsAlmostLinkEnd(*endTest)) {
-					++endTest;
-				}
-				if (endTest >= end || IsLinkEnd(*endTest)) {
-					break; // link finished at p
-				}
-				p = endTest;
-				ch = *p;
-			}
-			if (ch == '(' || ch == '[' || ch == '{' || ch == '<') {
-				parenth.push(p);
-			} else if (ch == ')' || ch == ']' || ch == '}' || ch == '>') {
-				if (parenth.isEmpty()) break;
-				const QChar *q = parenth.pop(), open(*q);
-				if ((ch == ')' && open != '(') || (ch == ']' && open != '[') || (ch == '}' && open != '{') || (ch == '>' && open != '<')) {
-					p = q;
-					break;
-				}
-			}
-		}
-		if (p > domainEnd) { // check, that domain ended
-			if (domainEnd->unicode() != '/' && domainEnd->unicode() != '?') {
-				matchOffset = domainEnd - start;
-				continue;
-			}
-		}
-		const auto range = MessageLinkRange{
-			int(domainOffset),
-			static_cast<int>(p - start - domainOffset),
-			QString()
-		};
-		processTagsBefore(domainOffset);
+	for (const auto &range : _scannedRanges) {
+		processTagsBefore(range.start);
 		if (!hasTagsIntersection(range.start + range.length)) {
 			if (markdownTagsAllow(range.start, range.length)) {
 				_ranges.push_back(range);
 			}
 		}
-		offset = matchOffset = p - start;
 	}
 	processTagsBefore(Ui::kQFixedMax);
 
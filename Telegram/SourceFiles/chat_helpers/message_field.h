@@ -167,12 +167,24 @@ public:
 private:
 	bool eventFilter(QObject *object, QEvent *event) override;
 
-	void parse();
+	void parse(bool allowAsync = false);
+	bool scan(const QString &text, bool allowAsync);
+	void updateScanned(
+		const QString &text,
+		int from,
+		int till,
+		std::vector<MessageLinkRange> &&found);
+	void applyTags();
 	void applyRanges(const QString &text);
 
 	not_null<Ui::InputField*> _field;
 	rpl::variable<QStringList> _list;
 	std::vector<MessageLinkRange> _ranges;
+
+	// Link ranges found in _scannedText before applying tags to them.
+	QString _scannedText;
+	std::vector<MessageLinkRange> _scannedRanges;
+	uint64 _scanRequestId = 0;
 	int _lastLength = 0;
 	bool _disabled = false;
 	base::Timer _timer;
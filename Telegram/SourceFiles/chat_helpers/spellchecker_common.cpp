@@ -10,6 +10,7 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 #ifndef TDESKTOP_DISABLE_SPELLCHECK
 
 #include "base/platform/base_platform_info.h"
+#include "base/timer.h"
 #include "base/weak_ptr.h"
 #include "base/zlib_help.h"
 #include "data/data_session.h"
@@ -20,12 +21,14 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 #include "main/main_session.h"
 #include "mainwidget.h"
 #include "mtproto/dedicated_file_loader.h"
+#include "spellcheck/platform/platform_language.h"
 #include "spellcheck/platform/platform_spellcheck.h"
 #include "spellcheck/spellcheck_utils.h"
 #include "spellcheck/spellcheck_value.h"
 #include "core/application.h"
 #include "core/core_settings.h"
 #include "core/version.h"
+#include "ui/widgets/fields/input_field.h"
 
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
@@ -49,6 +52,9 @@ constexpr auto kExceptions = {
 constexpr auto kLangsForLWC = { QLocale::English, QLocale::Portuguese };
 constexpr auto kDefaultCountries = { QLocale::UnitedStates, QLocale::Brazil };
 
+constexpr auto kRecognizeDelay = crl::time(1000);
+constexpr auto kRecognizeMinLength = 16;
+
 // Language With Country.
 inline auto LWC(QLocale::Language language, QLocale::Country country) {
 	if (ranges::contains(kDefaultCountries, country)) {
@@ -260,6 +266,57 @@ bool IsGoodPartName(const QString &name) {
 	});
 }
 
+// Only one session drives the spellchecker, the dictionaries are global.
+Main::Session *StartedSession = nullptr;
+
+// Hunspell dictionaries are loaded only for the languages the user
+// actually types in, the rest of the enabled ones stay on disk.
+base::flat_set<QLocale::Language> UsedLanguages;
+std::optional<std::vector<int>> LoadedDictionaries;
+
+[[nodiscard]] bool IsLanguageUsed(int langId) {
+	return !langId
+		|| Platform::Spellchecker::IsSystemSpellchecker()
+		|| UsedLanguages.contains(
+			Spellchecker::LocaleFromLangId(langId).language());
+}
+
+[[nodiscard]] bool AllLanguagesUsed() {
+	return ranges::all_of(
+		Core::App().settings().dictionariesEnabled(),
+		IsLanguageUsed);
+}
+
+void UpdateLoadedDictionaries() {
+	const auto settings = &Core::App().settings();
+	auto dictionaries = settings->spellcheckerEnabled()
+		? settings->dictionariesEnabled()
+		: std::vector<int>();
+	dictionaries.erase(
+		ranges::remove_if(dictionaries, std::not_fn(IsLanguageUsed)),
+		end(dictionaries));
+	if (LoadedDictionaries == dictionaries) {
+		return;
+	}
+	LoadedDictionaries = dictionaries;
+	Platform::Spellchecker::UpdateLanguages(std::move(dictionaries));
+}
+
+void UseLanguage(QLocale::Language language) {
+	if (UsedLanguages.emplace(language).second) {
+		UpdateLoadedDictionaries();
+	}
+}
+
+void UseDefaultLanguages() {
+	if (const auto method = QGuiApplication::inputMethod()) {
+		UsedLanguages.emplace(method->locale().language());
+	}
+	UsedLanguages.emplace(QLocale(Platform::SystemLanguage()).language());
+	UsedLanguages.emplace(
+		QLocale(Lang::LanguageIdOrDefault(Lang::Id())).language());
+}
+
 using DictLoaderPtr = std::shared_ptr<base::unique_qptr<DictLoader>>;
 
 DictLoaderPtr BackgroundLoader;
@@ -284,8 +341,11 @@ void DownloadDictionaryInBackground(
 
 		if (DictionaryExists(id)) {
 			auto dicts = Core::App().settings().dictionariesEnabled();
+			UsedLanguages.emplace(
+				Spellchecker::LocaleFromLangId(id).language());
 			if (ranges::contains(dicts, id)) {
-				Platform::Spellchecker::UpdateLanguages(dicts);
+				LoadedDictionaries = std::nullopt;
+				UpdateLoadedDictionaries();
 			} else {
 				dicts.push_back(id);
 				Core::App().settings().setDictionariesEnabled(
@@ -536,7 +596,37 @@ std::vector<int> DefaultLanguages() {
 	return langs;
 }
 
+void WatchFieldLanguage(not_null<Ui::InputField*> field) {
+	if (Platform::Spellchecker::IsSystemSpellchecker()) {
+		return;
+	}
+	const auto timer = field->lifetime().make_state<base::Timer>([=] {
+		const auto text = field->getLastText();
+		if (text.size() < kRecognizeMinLength || AllLanguagesUsed()) {
+			return;
+		}
+		crl::async([=] {
+			const auto id = Platform::Language::Recognize(text);
+			if (id) {
+				crl::on_main([language = id.language()] {
+					UseLanguage(language);
+				});
+			}
+		});
+	});
+	field->changes() | rpl::on_next([=] {
+		if (!timer->isActive() && !AllLanguagesUsed()) {
+			timer->callOnce(kRecognizeDelay);
+		}
+	}, field->lifetime());
+}
+
 void Start(not_null<Main::Session*> session) {
+	if (StartedSession) {
+		return;
+	}
+	StartedSession = session;
+
 	Spellchecker::SetPhrases({ {
 		{ &ph::lng_spellchecker_submenu, tr::lng_spellchecker_submenu() },
 		{ &ph::lng_spellchecker_add, tr::lng_spellchecker_add() },
@@ -546,16 +636,7 @@ void Start(not_null<Main::Session*> session) {
 	const auto settings = &Core::App().settings();
 	auto &lifetime = session->lifetime();
 
-	const auto onEnabled = [=](auto enabled) {
-		Platform::Spellchecker::UpdateLanguages(
-			enabled
-				? settings->dictionariesEnabled()
-				: std::vector<int>());
-	};
-
-	const auto guard = gsl::finally([=] {
-		onEnabled(settings->spellcheckerEnabled());
-	});
+	const auto guard = gsl::finally(UpdateLoadedDictionaries);
 
 	if (Platform::Spellchecker::IsSystemSpellchecker()) {
 		Spellchecker::SupportedScriptsChanged()
@@ -569,14 +650,27 @@ void Start(not_null<Main::Session*> session) {
 	) | rpl::on_next(AddExceptions, lifetime);
 
 	Spellchecker::SetWorkingDirPath(DictionariesPath());
+	UseDefaultLanguages();
 
+	// Dictionaries the user enables explicitly are loaded right away.
+	const auto enabled = lifetime.make_state<std::vector<int>>(
+		settings->dictionariesEnabled());
 	settings->dictionariesEnabledChanges(
-	) | rpl::on_next([](auto dictionaries) {
-		Platform::Spellchecker::UpdateLanguages(dictionaries);
+	) | rpl::on_next([=](std::vector<int> dictionaries) {
+		for (const auto langId : dictionaries) {
+			if (!ranges::contains(*enabled, langId)) {
+				UsedLanguages.emplace(
+					Spellchecker::LocaleFromLangId(langId).language());
+			}
+		}
+		*enabled = std::move(dictionaries);
+		UpdateLoadedDictionaries();
 	}, lifetime);
 
 	settings->spellcheckerEnabledChanges(
-	) | rpl::on_next(onEnabled, lifetime);
+	) | rpl::on_next([] {
+		UpdateLoadedDictionaries();
+	}, lifetime);
 
 	const auto method = QGuiApplication::inputMethod();
 
@@ -639,6 +733,7 @@ void Start(not_null<Main::Session*> session) {
 	};
 	lifetime.add([=] {
 		disconnect();
+		StartedSession = nullptr;
 		for (auto &[index, account] : session->domain().accounts()) {
 			if (const auto anotherSession = account->maybeSession()) {
 				if (anotherSession->uniqueId() != session->uniqueId()) {
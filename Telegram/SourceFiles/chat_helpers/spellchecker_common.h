@@ -16,6 +16,10 @@ namespace Main {
 class Session;
 } // namespace Main
 
+namespace Ui {
+class InputField;
+} // namespace Ui
+
 namespace Spellchecker {
 
 struct Dict : public Storage::CloudBlob::Blob {
@@ -38,6 +42,7 @@ rpl::producer<> DictionariesChanged();
 void RefreshDictionariesManifest(not_null<Main::Session*> session);
 
 void Start(not_null<Main::Session*> session);
+void WatchFieldLanguage(not_null<Ui::InputField*> field);
 [[nodiscard]] rpl::producer<QString> ButtonManageDictsState(
 	not_null<Main::Session*> session);
 
@@ -80,6 +80,7 @@ constexpr auto kPreloadOfficialPages = 4;
 constexpr auto kOfficialLoadLimit = 40;
 constexpr auto kMinRepaintDelay = crl::time(33);
 constexpr auto kMinAfterScrollDelay = crl::time(33);
+constexpr auto kMaxAnimatedSets = 8;
 
 using Data::StickersSet;
 using Data::StickersPack;
@@ -296,6 +297,13 @@ StickersListWidget::StickersListWidget(
 		}, lifetime());
 	}
 
+	shownValue(
+	) | rpl::filter([](bool shown) {
+		return shown;
+	}) | rpl::take(1) | rpl::on_next([=] {
+		_firstShownAt = crl::now();
+	}, lifetime());
+
 	positionValue(
 	) | rpl::skip(1) | rpl::map_to(
 		TabbedSelector::Action::Update
@@ -434,6 +442,7 @@ void StickersListWidget::preloadMoreOfficial() {
 		}, [&](const MTPDmessages_featuredStickers &data) {
 			const auto &list = data.vsets().v;
 			_officialOffset += list.size();
+			invalidateSectionsGeometry();
 			for (int i = 0, l = list.size(); i != l; ++i) {
 				const auto set = session().data().stickers().feedSet(
 					list[i]);
@@ -500,9 +509,21 @@ int StickersListWidget::featuredRowHeight() const {
 
 template <typename Callback>
 bool StickersListWidget::enumerateSections(Callback callback) const {
+	if (!sectionsGeometryValid()) {
+		return countSections(std::move(callback));
+	}
+	for (auto i = 0; i != int(_sectionsGeometry.size()); ++i) {
+		if (!callback(_sectionsGeometry[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <typename Callback>
+bool StickersListWidget::countSections(Callback callback) const {
 	auto info = SectionInfo();
-	info.top = _search ? _search->height() : 0;
-	info.top += searchShortcutsHeight();
+	info.top = sectionsTop();
 	const auto &sets = shownSets();
 	for (auto i = 0; i != sets.size(); ++i) {
 		auto &set = sets[i];
@@ -542,10 +563,40 @@ bool StickersListWidget::enumerateSections(Callback callback) const {
 	return true;
 }
 
+int StickersListWidget::sectionsTop() const {
+	return (_search ? _search->height() : 0) + searchShortcutsHeight();
+}
+
+bool StickersListWidget::sectionsGeometryValid() const {
+	return !_sectionsGeometryOutdated
+		&& (_sectionsGeometryFor == _section)
+		&& (_sectionsGeometry.size() == shownSets().size())
+		&& (_sectionsGeometryTop == sectionsTop());
+}
+
+void StickersListWidget::invalidateSectionsGeometry() {
+	_sectionsGeometryOutdated = true;
+}
+
+void StickersListWidget::refreshSectionsGeometry() {
+	_sectionsGeometry.clear();
+	_sectionsGeometry.reserve(shownSets().size());
+	countSections([&](const SectionInfo &info) {
+		_sectionsGeometry.push_back(info);
+		return true;
+	});
+	_sectionsGeometryFor = _section;
+	_sectionsGeometryTop = sectionsTop();
+	_sectionsGeometryOutdated = false;
+}
+
 StickersListWidget::SectionInfo StickersListWidget::sectionInfo(
 		int section) const {
 	Expects(section >= 0 && section < shownSets().size());
 
+	if (sectionsGeometryValid()) {
+		return _sectionsGeometry[section];
+	}
 	auto result = SectionInfo();
 	enumerateSections([searchForSection = section, &result](
 			const SectionInfo &info) {
@@ -560,6 +611,16 @@ StickersListWidget::SectionInfo StickersListWidget::sectionInfo(
 
 StickersListWidget::SectionInfo StickersListWidget::sectionInfoByOffset(
 		int yOffset) const {
+	if (sectionsGeometryValid() && !_sectionsGeometry.empty()) {
+		const auto i = ranges::upper_bound(
+			_sectionsGeometry,
+			yOffset,
+			ranges::less(),
+			&SectionInfo::rowsBottom);
+		return (i != end(_sectionsGeometry))
+			? *i
+			: _sectionsGeometry.back();
+	}
 	auto result = SectionInfo();
 	enumerateSections([this, &result, yOffset](const SectionInfo &info) {
 		if (yOffset < info.rowsBottom
@@ -593,6 +654,7 @@ int StickersListWidget::countDesiredHeight(int newWidth) {
 	_singleSize = QSize(singleWidth, singleWidth);
 	setColumnCount(columnCount);
 	refreshSearchShortcutsScroll(newWidth);
+	refreshSectionsGeometry();
 
 	auto visibleHeight = minimalHeight();
 	auto minimalHeight = (visibleHeight - st::stickerPanPadding);
@@ -767,6 +829,7 @@ void StickersListWidget::refreshSearchRows() {
 void StickersListWidget::refreshSearchRows(
 		const std::vector<uint64> *cloudSets) {
 	clearSelection();
+	invalidateSectionsGeometry();
 
 	const auto wasSection = _section;
 	auto wasSets = base::take(_searchSets);
@@ -1357,6 +1420,11 @@ QRect StickersListWidget::stickerRect(int section, int sel) {
 }
 
 void StickersListWidget::paintEvent(QPaintEvent *e) {
+	if (const auto shownAt = base::take(_firstShownAt)) {
+		DEBUG_LOG(("Stickers Panel: first paint %1 ms after shown, %2 sets."
+			).arg(crl::now() - shownAt
+			).arg(shownSets().size()));
+	}
 	Painter p(this);
 	auto clip = e->rect();
 	if (st().bg->c.alpha() > 0) {
@@ -1880,6 +1948,45 @@ void StickersListWidget::checkVisibleLottie() {
 		}
 		return true;
 	});
+	limitAnimatedSets(visibleTop, visibleBottom);
+}
+
+void StickersListWidget::limitAnimatedSets(
+		int visibleTop,
+		int visibleBottom) {
+	// Sets farther than that are already cleared by checkVisibleLottie.
+	const auto checkDistance = (visibleBottom - visibleTop) * 2;
+	auto animated = std::vector<std::pair<int, int>>();
+	enumerateSections([&](const SectionInfo &info) {
+		const auto distance = (info.rowsBottom <= visibleTop)
+			? (visibleTop - info.rowsBottom)
+			: (info.rowsTop >= visibleBottom)
+			? (info.rowsTop - visibleBottom)
+			: 0;
+		if (distance > checkDistance) {
+			return (info.rowsTop < visibleBottom);
+		}
+		const auto &set = shownSets()[info.section];
+		const auto has = set.lottiePlayer
+			|| ranges::any_of(set.stickers, [](const Sticker &sticker) {
+				return sticker.webm != nullptr;
+			});
+		if (has) {
+			animated.emplace_back(distance, info.section);
+		}
+		return true;
+	});
+	if (int(animated.size()) <= kMaxAnimatedSets) {
+		return;
+	}
+	// Sets far from the visible area give away their players first.
+	ranges::sort(animated);
+	for (auto i = kMaxAnimatedSets; i != int(animated.size()); ++i) {
+		const auto &[distance, section] = animated[i];
+		if (distance > 0) {
+			clearHeavyIn(shownSets()[section]);
+		}
+	}
 }
 
 void StickersListWidget::clearHeavyIn(Set &set, bool clearSavedFrames) {
@@ -2942,6 +3049,7 @@ void StickersListWidget::resizeEvent(QResizeEvent *e) {
 		height() / 3);
 	if (!_megagroupSetAbout.isEmpty()) {
 		refreshMegagroupSetGeometry();
+		refreshSectionsGeometry();
 	}
 }
 
@@ -2993,6 +3101,7 @@ void StickersListWidget::setSection(Section section) {
 	}
 	clearHeavyData();
 	_section = section;
+	invalidateSectionsGeometry();
 	_recentShownCount = (section == Section::Search)
 		? _filteredStickers.size()
 		: _mySets.empty()
@@ -3010,7 +3119,9 @@ void StickersListWidget::clearHeavyData() {
 }
 
 void StickersListWidget::refreshStickers() {
+	const auto started = crl::now();
 	clearSelection();
+	invalidateSectionsGeometry();
 
 	if (_isEffects) {
 		refreshEffects();
@@ -3031,6 +3142,10 @@ void StickersListWidget::refreshStickers() {
 	repaintItems();
 
 	visibleTopBottomUpdated(getVisibleTop(), getVisibleBottom());
+
+	DEBUG_LOG(("Stickers Panel: refreshed %1 sets in %2 ms."
+		).arg(_mySets.size()
+		).arg(crl::now() - started));
 }
 
 void StickersListWidget::refreshEffects() {
@@ -3313,6 +3428,9 @@ auto StickersListWidget::collectRecentStickers() -> std::vector<Sticker> {
 
 void StickersListWidget::refreshRecentStickers(bool performResize) {
 	clearSelection();
+	if (_section == Section::Stickers) {
+		invalidateSectionsGeometry();
+	}
 
 	auto recentPack = collectRecentStickers();
 	if (_section == Section::Stickers) {
@@ -266,6 +266,12 @@ private:
 
 	template <typename Callback>
 	bool enumerateSections(Callback callback) const;
+	template <typename Callback>
+	bool countSections(Callback callback) const;
+	[[nodiscard]] int sectionsTop() const;
+	[[nodiscard]] bool sectionsGeometryValid() const;
+	void invalidateSectionsGeometry();
+	void refreshSectionsGeometry();
 	SectionInfo sectionInfo(int section) const;
 	SectionInfo sectionInfoByOffset(int yOffset) const;
 
@@ -333,6 +339,7 @@ private:
 	[[nodiscard]] bool itemVisible(const SectionInfo &info, int index) const;
 	void markLottieFrameShown(Set &set);
 	void checkVisibleLottie();
+	void limitAnimatedSets(int visibleTop, int visibleBottom);
 	void pauseInvisibleLottieIn(const SectionInfo &info);
 	void takeHeavyData(std::vector<Set> &to, std::vector<Set> &from);
 	void takeHeavyData(Set &to, Set &from);
@@ -461,6 +468,7 @@ private:
 	bool _showingSetById = false;
 	crl::time _lastScrolledAt = 0;
 	crl::time _lastFullUpdatedAt = 0;
+	crl::time _firstShownAt = 0;
 
 	mtpRequestId _officialRequestId = 0;
 	int _officialOffset = 0;
@@ -479,6 +487,11 @@ private:
 	int _columnCount = 1;
 	QSize _singleSize;
 
+	std::vector<SectionInfo> _sectionsGeometry;
+	Section _sectionsGeometryFor = Section::Stickers;
+	int _sectionsGeometryTop = 0;
+	bool _sectionsGeometryOutdated = true;
+
 	OverState _selected;
 	OverState _pressed;
 	QPoint _lastMousePosition;
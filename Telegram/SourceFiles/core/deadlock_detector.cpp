@@ -0,0 +1,190 @@
+/*
+This file is part of FAgram Desktop,
+the unofficial desktop client based on Telegram Desktop.
+
+For license and copyright information please follow this link:
+https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
+*/
+#include "core/deadlock_detector.h"
+
+#include <QtCore/QFile>
+
+#include <array>
+#include <atomic>
+#include <limits>
+
+namespace Core::DeadlockDetector {
+namespace {
+
+constexpr auto kHeartbeatInterval = crl::time(20);
+constexpr auto kStallThreshold = crl::time(100);
+constexpr auto kFlushInterval = 60 * crl::time(1000);
+constexpr auto kTraceDepth = 16;
+constexpr auto kMaxSamples = 1024;
+
+// Upper bounds of the stall duration histogram buckets.
+constexpr auto kDurationBuckets = std::array<crl::time, 6>{
+	200,
+	500,
+	1000,
+	2000,
+	5000,
+	std::numeric_limits<crl::time>::max(),
+};
+
+struct TraceFrame {
+	std::atomic<const char*> name = nullptr;
+	std::atomic<int> type = 0;
+};
+
+std::array<TraceFrame, kTraceDepth> TraceFrames;
+std::atomic<int> TraceDepth = 0;
+std::atomic<bool> TraceEnabled = false;
+
+[[nodiscard]] QByteArray CaptureTrace() {
+	const auto depth = TraceDepth.load(std::memory_order_acquire);
+	auto result = QByteArray();
+	for (auto i = 0, till = std::min(depth, kTraceDepth); i != till; ++i) {
+		const auto &frame = TraceFrames[i];
+		const auto name = frame.name.load(std::memory_order_relaxed);
+		if (!result.isEmpty()) {
+			result.append(" > ");
+		}
+		result.append(name ? name : "?");
+		result.append(':');
+		result.append(QByteArray::number(
+			frame.type.load(std::memory_order_relaxed)));
+	}
+	if (depth > kTraceDepth) {
+		result.append(" > ...");
+	}
+	return result.isEmpty() ? QByteArray("(event loop)") : result;
+}
+
+} // namespace
+
+EventTrace::EventTrace(QObject *receiver, not_null<QEvent*> e) {
+	if (!receiver || !TraceEnabled.load(std::memory_order_relaxed)) {
+		return;
+	}
+	const auto depth = TraceDepth.load(std::memory_order_relaxed);
+	if (depth < kTraceDepth) {
+		auto &frame = TraceFrames[depth];
+		frame.name.store(
+			receiver->metaObject()->className(),
+			std::memory_order_relaxed);
+		frame.type.store(int(e->type()), std::memory_order_relaxed);
+	}
+	TraceDepth.store(depth + 1, std::memory_order_release);
+	_pushed = true;
+}
+
+EventTrace::~EventTrace() {
+	if (_pushed) {
+		TraceDepth.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+StallProfiler::StallProfiler(not_null<QObject*> receiver, QString folder)
+: _receiver(receiver)
+, _path(folder + u"stalls.txt"_q)
+, _heartbeatTimer([=] { heartbeat(); })
+, _flushTimer([=] { flush(); })
+, _durations(kDurationBuckets.size()) {
+	// Keep the statistics of the previous launch one more time.
+	const auto previous = folder + u"stalls_previous.txt"_q;
+	QFile::remove(previous);
+	QFile::rename(_path, previous);
+
+	TraceEnabled = true;
+	_heartbeatTimer.callEach(kHeartbeatInterval);
+	_flushTimer.callEach(kFlushInterval);
+}
+
+StallProfiler::~StallProfiler() {
+	TraceEnabled = false;
+	flush();
+}
+
+bool StallProfiler::event(QEvent *e) {
+	if (e->type() == PingPongEvent::Type()
+		&& static_cast<PingPongEvent*>(e)->sender() == _receiver) {
+		const auto duration = crl::now() - base::take(_pingSent);
+		if (base::take(_stalled)) {
+			finishStall(duration);
+		}
+	}
+	return QObject::event(e);
+}
+
+void StallProfiler::heartbeat() {
+	if (!_pingSent) {
+		_pingSent = crl::now();
+		QCoreApplication::postEvent(_receiver, new PingPongEvent(this));
+	} else if (crl::now() - _pingSent >= kStallThreshold) {
+		_stalled = true;
+		sample();
+	}
+}
+
+void StallProfiler::sample() {
+	auto trace = CaptureTrace();
+	const auto i = _samples.find(trace);
+	if (i != end(_samples)) {
+		++i->second;
+	} else if (int(_samples.size()) < kMaxSamples) {
+		_samples.emplace(std::move(trace), 1);
+	} else {
+		++_samples[QByteArray("(other)")];
+	}
+	_dirty = true;
+}
+
+void StallProfiler::finishStall(crl::time duration) {
+	const auto i = ranges::upper_bound(kDurationBuckets, duration);
+	++_durations[std::distance(begin(kDurationBuckets), i)];
+	_dirty = true;
+}
+
+void StallProfiler::flush() {
+	if (!base::take(_dirty)) {
+		return;
+	}
+	auto file = QFile(_path);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		return;
+	}
+	auto content = QByteArray("Main thread stalls longer than ")
+		+ QByteArray::number(kStallThreshold)
+		+ " ms.\n\nDurations:\n";
+	auto from = kStallThreshold;
+	for (auto i = 0, count = int(kDurationBuckets.size()); i != count; ++i) {
+		const auto till = kDurationBuckets[i];
+		const auto range = (i + 1 < count)
+			? (QByteArray::number(from) + '-' + QByteArray::number(till - 1))
+			: (QByteArray::number(from) + '+');
+		content += "  "
+			+ range
+			+ " ms: "
+			+ QByteArray::number(_durations[i])
+			+ '\n';
+		from = till;
+	}
+	content += "\nSamples every "
+		+ QByteArray::number(kHeartbeatInterval)
+		+ " ms, by event trace (receiver:event type):\n";
+	auto sorted = std::vector<std::pair<int, QByteArray>>();
+	sorted.reserve(_samples.size());
+	for (const auto &[trace, count] : _samples) {
+		sorted.emplace_back(count, trace);
+	}
+	ranges::sort(sorted, ranges::greater(), [](const auto &pair) {
+		return pair.first;
+	});
+	for (const auto &[count, trace] : sorted) {
+		content += "  " + QByteArray::number(count) + "  " + trace + '\n';
+	}
+	file.write(content);
+}
+
+} // namespace Core::DeadlockDetector
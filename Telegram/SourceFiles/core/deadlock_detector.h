@@ -80,4 +80,68 @@ protected:
 
 };
 
+// Records receivers and types of the events being delivered on the main
+// thread while the stall profiler is running.
+class EventTrace final {
+public:
+	EventTrace(QObject *receiver, not_null<QEvent*> e);
+	~EventTrace();
+
+private:
+	bool _pushed = false;
+
+};
+
+// Pings the main thread often and samples its event trace each time a
+// ping stays unanswered for too long, keeping the statistics in a file.
+class StallProfiler final : public QObject {
+public:
+	StallProfiler(not_null<QObject*> receiver, QString folder);
+	~StallProfiler();
+
+protected:
+	bool event(QEvent *e) override;
+
+private:
+	void heartbeat();
+	void sample();
+	void finishStall(crl::time duration);
+	void flush();
+
+	not_null<QObject*> _receiver;
+	QString _path;
+	base::Timer _heartbeatTimer;
+	base::Timer _flushTimer;
+	crl::time _pingSent = 0;
+	bool _stalled = false;
+	base::flat_map<QByteArray, int> _samples;
+	std::vector<int> _durations;
+	bool _dirty = false;
+
+};
+
+class StallProfilerThread : public QThread {
+public:
+	StallProfilerThread(not_null<QObject*> parent, QString folder)
+	: QThread(parent)
+	, _folder(std::move(folder)) {
+		start();
+	}
+
+	~StallProfilerThread() {
+		quit();
+		wait();
+	}
+
+protected:
+	void run() override {
+		StallProfiler profiler(parent(), _folder);
+		QThread::run();
+	}
+
+private:
+	QString _folder;
+
+};
+
 } // namespace Core::DeadlockDetector
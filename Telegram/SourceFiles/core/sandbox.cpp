@@ -49,12 +49,20 @@ base::options::toggle OptionDeadlockDetector({
 	.description = "Check once every 30 seconds that main thread is still responsive.",
 });
 
+base::options::toggle OptionStallProfiler({
+	.id = kOptionStallProfiler,
+	.name = "Stall Profiler",
+	.description = "Sample main thread events when it is blocked for more "
+		"than 100 ms and write the statistics to stalls.txt.",
+});
+
 constexpr auto kCleanupIpcTimeout = 10 * crl::time(1000);
 constexpr auto kCleanupQuitTimeout = 30 * crl::time(1000);
 
 } // namespace
 
 const char kOptionDeadlockDetector[] = "deadlock-detector";
+const char kOptionStallProfiler[] = "stall-profiler";
 
 bool Sandbox::QuitOnStartRequested = false;
 bool Sandbox::SystemShuttingDown = false;
@@ -264,6 +272,17 @@ void Sandbox::launchApplication() {
 				: nullptr;
 		}, _lifetime);
 
+		rpl::single(
+			rpl::empty
+		) | rpl::then(
+			OptionStallProfiler.changes()
+		) | rpl::on_next([=] {
+			using DeadlockDetector::StallProfilerThread;
+			_stallProfiler = OptionStallProfiler.value()
+				? std::make_unique<StallProfilerThread>(this, cWorkingDir())
+				: nullptr;
+		}, _lifetime);
+
 		_application = std::make_unique<Application>();
 
 		// Ideally this should go to constructor.
@@ -651,6 +670,7 @@ bool Sandbox::notify(QObject *receiver, QEvent *e) {
 	}
 
 	const auto wrap = createEventNestingLevel();
+	const auto trace = DeadlockDetector::EventTrace(receiver, e);
 	if (e->type() == QEvent::UpdateRequest) {
 		const auto weak = QPointer<QObject>(receiver);
 		_widgetUpdateRequests.fire({});
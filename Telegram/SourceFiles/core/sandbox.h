@@ -19,6 +19,7 @@ class QLockFile;
 namespace Core {
 
 extern const char kOptionDeadlockDetector[];
+extern const char kOptionStallProfiler[];
 
 class UpdateChecker;
 class Application;
@@ -147,6 +148,7 @@ private:
 	rpl::event_stream<> _widgetUpdateRequests;
 
 	std::unique_ptr<QThread> _deadlockDetector;
+	std::unique_ptr<QThread> _stallProfiler;
 
 	rpl::lifetime _lifetime;
 
@@ -31,6 +31,7 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 #include "settings/settings_intro.h"
 #include "ui/layers/box_content.h"
 
+#include <QtCore/QBuffer>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QFileSystemWatcher>
@@ -48,6 +49,7 @@ extern "C" {
 #include <openssl/pem.h>
 #include <openssl/bio.h>
 #include <openssl/err.h>
+#include <openssl/sha.h>
 } // extern "C"
 
 #ifndef TDESKTOP_DISABLE_AUTOUPDATE
@@ -67,6 +69,7 @@ namespace {
 
 constexpr auto kUpdaterTimeout = 10 * crl::time(1000);
 constexpr auto kMaxResponseSize = 1024 * 1024;
+constexpr auto kUnpackChunkSize = 1024 * 1024;
 
 #if !defined Q_OS_WIN && !defined Q_OS_MAC
 constexpr auto kFlatpakPortalService = "org.freedesktop.portal.Flatpak";
@@ -343,13 +346,12 @@ bool UnpackUpdate(const QString &filepath) {
 	const int32 hSigLen = 128, hShaLen = 20, hPropsLen = 0, hOriginalSizeLen = sizeof(int64), hSize = hSigLen + hShaLen + hOriginalSizeLen; // header
 #endif // Q_OS_WIN && !TDESKTOP_USE_PACKAGED
 
-	QByteArray compressed = input.readAll();
-	int32 compressedLen = compressed.size() - hSize;
-	if (compressedLen <= 0) {
-		LOG(("Update Error: bad compressed size: %1").arg(compressed.size()));
+	const auto header = input.read(hSize);
+	const auto compressedLen = input.size() - hSize;
+	if (header.size() != hSize || compressedLen <= 0) {
+		LOG(("Update Error: bad compressed size: %1").arg(input.size()));
 		return false;
 	}
-	input.close();
 
 	QString tempDirPath = cWorkingDir() + u"tupdates/temp"_q, readyFilePath = cWorkingDir() + u"tupdates/temp/ready"_q;
 	base::Platform::DeleteDirectory(tempDirPath);
@@ -360,8 +362,27 @@ bool UnpackUpdate(const QString &filepath) {
 		return false;
 	}
 
+	// Hash the update by chunks, it may be large.
+	auto buffer = QByteArray(kUnpackChunkSize, Qt::Uninitialized);
+	SHA_CTX sha1;
+	SHA1_Init(&sha1);
+	SHA1_Update(
+		&sha1,
+		header.constData() + hSigLen + hShaLen,
+		hPropsLen + hOriginalSizeLen);
+	while (true) {
+		const auto read = input.read(buffer.data(), buffer.size());
+		if (read < 0) {
+			LOG(("Update Error: cant read updates file!"));
+			return false;
+		} else if (!read) {
+			break;
+		}
+		SHA1_Update(&sha1, buffer.constData(), read);
+	}
 	uchar sha1Buffer[20];
-	bool goodSha1 = !memcmp(compressed.constData() + hSigLen, hashSha1(compressed.constData() + hSigLen + hShaLen, compressedLen + hPropsLen + hOriginalSizeLen, sha1Buffer), hShaLen);
+	SHA1_Final(sha1Buffer, &sha1);
+	bool goodSha1 = !memcmp(header.constData() + hSigLen, sha1Buffer, hShaLen);
 	if (!goodSha1) {
 		LOG(("Update Error: bad SHA1 hash of update file!"));
 		return false;
@@ -380,7 +401,7 @@ bool UnpackUpdate(const QString &filepath) {
 		LOG(("Update Error: cant read public rsa key!"));
 		return false;
 	}
-	if (RSA_verify(NID_sha1, (const uchar*)(compressed.constData() + hSigLen), hShaLen, (const uchar*)(compressed.constData()), hSigLen, pbKey) != 1) { // verify signature
+	if (RSA_verify(NID_sha1, (const uchar*)(header.constData() + hSigLen), hShaLen, (const uchar*)(header.constData()), hSigLen, pbKey) != 1) { // verify signature
 		RSA_free(pbKey);
 
 		// try other public key, if we update from beta to stable or vice versa
@@ -397,7 +418,7 @@ bool UnpackUpdate(const QString &filepath) {
 			LOG(("Update Error: cant read public rsa key!"));
 			return false;
 		}
-		if (RSA_verify(NID_sha1, (const uchar*)(compressed.constData() + hSigLen), hShaLen, (const uchar*)(compressed.constData()), hSigLen, pbKey) != 1) { // verify signature
+		if (RSA_verify(NID_sha1, (const uchar*)(header.constData() + hSigLen), hShaLen, (const uchar*)(header.constData()), hSigLen, pbKey) != 1) { // verify signature
 			RSA_free(pbKey);
 			LOG(("Update Error: bad RSA signature of update file!"));
 			return false;
@@ -405,21 +426,41 @@ bool UnpackUpdate(const QString &filepath) {
 	}
 	RSA_free(pbKey);
 
-	QByteArray uncompressed;
-
 	int64 uncompressedLen;
-	memcpy(&uncompressedLen, compressed.constData() + hSigLen + hShaLen + hPropsLen, hOriginalSizeLen);
+	memcpy(&uncompressedLen, header.constData() + hSigLen + hShaLen + hPropsLen, hOriginalSizeLen);
+
+	if (!input.seek(hSize)) {
+		LOG(("Update Error: cant seek in updates file!"));
+		return false;
+	}
+
+#if defined Q_OS_WIN && !defined TDESKTOP_USE_PACKAGED // use Lzma SDK for win
+	const auto compressed = input.readAll();
+	QByteArray uncompressed;
 	uncompressed.resize(int(uncompressedLen));
 
 	size_t resultLen = uncompressed.size();
-#if defined Q_OS_WIN && !defined TDESKTOP_USE_PACKAGED // use Lzma SDK for win
-	SizeT srcLen = compressedLen;
-	int uncompressRes = LzmaUncompress((uchar*)uncompressed.data(), &resultLen, (const uchar*)(compressed.constData() + hSize), &srcLen, (const uchar*)(compressed.constData() + hSigLen + hShaLen), LZMA_PROPS_SIZE);
+	SizeT srcLen = compressed.size();
+	int uncompressRes = LzmaUncompress((uchar*)uncompressed.data(), &resultLen, (const uchar*)(compressed.constData()), &srcLen, (const uchar*)(header.constData() + hSigLen + hShaLen), LZMA_PROPS_SIZE);
 	if (uncompressRes != SZ_OK) {
 		LOG(("Update Error: could not uncompress lzma, code: %1").arg(uncompressRes));
 		return false;
 	}
+	auto unpacked = std::make_unique<QBuffer>();
+	unpacked->setData(uncompressed);
+	unpacked->open(QIODevice::ReadOnly);
 #else // Q_OS_WIN && !TDESKTOP_USE_PACKAGED
+	// Decompress to a file by chunks instead of holding it in memory.
+	const auto unpackedPath = cWorkingDir() + u"tupdates/unpacked"_q;
+	const auto removeUnpacked = gsl::finally([&] {
+		QFile::remove(unpackedPath);
+	});
+	auto unpacked = std::make_unique<QFile>(unpackedPath);
+	if (!unpacked->open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+		LOG(("Update Error: cant open file '%1' for writing").arg(unpackedPath));
+		return false;
+	}
+
 	lzma_stream stream = LZMA_STREAM_INIT;
 
 	lzma_ret ret = lzma_stream_decoder(&stream, UINT64_MAX, LZMA_CONCATENATED);
@@ -434,22 +475,39 @@ bool UnpackUpdate(const QString &filepath) {
 		LOG(("Error initializing the decoder: %1 (error code %2)").arg(msg).arg(ret));
 		return false;
 	}
+	const auto endStream = gsl::finally([&] {
+		lzma_end(&stream);
+	});
 
-	stream.avail_in = compressedLen;
-	stream.next_in = (uint8_t*)(compressed.constData() + hSize);
-	stream.avail_out = resultLen;
-	stream.next_out = (uint8_t*)uncompressed.data();
-
-	lzma_ret res = lzma_code(&stream, LZMA_FINISH);
-	if (stream.avail_in) {
-		LOG(("Error in decompression, %1 bytes left in _in of %2 whole.").arg(stream.avail_in).arg(compressedLen));
-		return false;
-	} else if (stream.avail_out) {
-		LOG(("Error in decompression, %1 bytes free left in _out of %2 whole.").arg(stream.avail_out).arg(resultLen));
-		return false;
+	auto output = QByteArray(kUnpackChunkSize, Qt::Uninitialized);
+	auto action = LZMA_RUN;
+	auto res = LZMA_OK;
+	auto unpackedLen = int64(0);
+	while (res == LZMA_OK) {
+		if (!stream.avail_in && action == LZMA_RUN) {
+			const auto read = input.read(buffer.data(), buffer.size());
+			if (read < 0) {
+				LOG(("Update Error: cant read updates file!"));
+				return false;
+			} else if (!read) {
+				action = LZMA_FINISH;
+			}
+			stream.next_in = (const uint8_t*)buffer.constData();
+			stream.avail_in = size_t(read);
+		}
+		stream.next_out = (uint8_t*)output.data();
+		stream.avail_out = size_t(output.size());
+		res = lzma_code(&stream, action);
+
+		const auto produced = int64(output.size() - stream.avail_out);
+		if (produced > 0
+			&& unpacked->write(output.constData(), produced) != produced) {
+			LOG(("Update Error: cant write file '%1'").arg(unpackedPath));
+			return false;
+		}
+		unpackedLen += produced;
 	}
-	lzma_end(&stream);
-	if (res != LZMA_OK && res != LZMA_STREAM_END) {
+	if (res != LZMA_STREAM_END) {
 		const char *msg;
 		switch (res) {
 		case LZMA_MEM_ERROR: msg = "Memory allocation failed"; break;
@@ -461,6 +519,12 @@ bool UnpackUpdate(const QString &filepath) {
 		}
 		LOG(("Error in decompression: %1 (error code %2)").arg(msg).arg(res));
 		return false;
+	} else if (unpackedLen != uncompressedLen) {
+		LOG(("Error in decompression, %1 bytes unpacked of %2 whole.").arg(unpackedLen).arg(uncompressedLen));
+		return false;
+	} else if (!unpacked->seek(0)) {
+		LOG(("Update Error: cant seek in file '%1'").arg(unpackedPath));
+		return false;
 	}
 #endif // Q_OS_WIN && !TDESKTOP_USE_PACKAGED
 
@@ -468,7 +532,7 @@ bool UnpackUpdate(const QString &filepath) {
 
 	quint32 version;
 	{
-		QDataStream stream(uncompressed);
+		QDataStream stream(unpacked.get());
 		stream.setVersion(QDataStream::Qt_5_1);
 
 		stream >> version;
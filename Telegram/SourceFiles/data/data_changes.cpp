@@ -10,6 +10,11 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 #include "main/main_session.h"
 
 namespace Data {
+namespace {
+
+constexpr auto kSlowNotificationsDuration = crl::time(16);
+
+} // namespace
 
 template <typename DataType, typename UpdateType>
 void Changes::Manager<DataType, UpdateType>::updated(
@@ -23,7 +28,7 @@ void Changes::Manager<DataType, UpdateType>::updated(
 			flags |= i->second;
 			_updates.erase(i);
 		}
-		_stream.fire({ data, flags });
+		fire({ data, flags });
 	} else {
 		_updates[data] |= flags;
 	}
@@ -54,11 +59,96 @@ template <typename DataType, typename UpdateType>
 rpl::producer<UpdateType> Changes::Manager<DataType, UpdateType>::updates(
 		not_null<DataType*> data,
 		Flags flags) const {
-	return _stream.events(
-	) | rpl::filter([=](const UpdateType &update) {
-		const auto &[updateData, updateFlags] = update;
-		return (updateData == data) && (updateFlags & flags);
-	});
+	const auto weak = std::weak_ptr<KeyedListeners>(_keyed);
+	return [=](auto consumer) {
+		const auto keyed = weak.lock();
+		if (!keyed) {
+			return rpl::lifetime();
+		}
+		auto &list = keyed->streams[data];
+		auto i = ranges::find_if(list, [&](const auto &stream) {
+			return (stream->flags == flags);
+		});
+		if (i == end(list)) {
+			list.push_back(std::make_unique<KeyedStream>());
+			list.back()->flags = flags;
+			i = end(list) - 1;
+		}
+		const auto stream = i->get();
+		++stream->subscribers;
+
+		// The subscription is destroyed before the stream may be removed.
+		auto result = rpl::lifetime([=] {
+			if (const auto keyed = weak.lock()) {
+				Unsubscribe(*keyed, data, stream);
+			}
+		});
+		result.add(stream->stream.events().start_existing(consumer));
+		return result;
+	};
+}
+
+template <typename DataType, typename UpdateType>
+void Changes::Manager<DataType, UpdateType>::fire(const UpdateType &update) {
+	_stream.fire_copy(update);
+
+	const auto &[data, flags] = update;
+	auto &keyed = *_keyed;
+	const auto i = keyed.streams.find(data);
+	if (i == end(keyed.streams)) {
+		return;
+	}
+	auto targets = std::vector<not_null<KeyedStream*>>();
+	for (const auto &stream : i->second) {
+		if (stream->flags & flags) {
+			targets.push_back(stream.get());
+		}
+	}
+	if (targets.empty()) {
+		return;
+	}
+
+	// Streams are not removed while dispatching, listeners may unsubscribe.
+	++keyed.dispatching;
+	for (const auto stream : targets) {
+		stream->stream.fire_copy(update);
+	}
+	if (!--keyed.dispatching) {
+		for (const auto unused : base::take(keyed.cleanup)) {
+			RemoveUnused(keyed, unused);
+		}
+	}
+}
+
+template <typename DataType, typename UpdateType>
+void Changes::Manager<DataType, UpdateType>::Unsubscribe(
+		KeyedListeners &keyed,
+		not_null<DataType*> data,
+		not_null<KeyedStream*> stream) {
+	if (--stream->subscribers > 0) {
+		return;
+	} else if (keyed.dispatching) {
+		keyed.cleanup.push_back(data);
+	} else {
+		RemoveUnused(keyed, data);
+	}
+}
+
+template <typename DataType, typename UpdateType>
+void Changes::Manager<DataType, UpdateType>::RemoveUnused(
+		KeyedListeners &keyed,
+		not_null<DataType*> data) {
+	const auto i = keyed.streams.find(data);
+	if (i == end(keyed.streams)) {
+		return;
+	}
+	auto &list = i->second;
+	list.erase(ranges::remove(list, 0, [](const auto &stream) {
+		return stream->subscribers;
+	}), end(list));
+	if (list.empty()) {
+		keyed.streams.erase(i);
+	}
 }
 
 template <typename DataType, typename UpdateType>
@@ -84,7 +174,7 @@ void Changes::Manager<DataType, UpdateType>::drop(not_null<DataType*> data) {
 template <typename DataType, typename UpdateType>
 void Changes::Manager<DataType, UpdateType>::sendNotifications() {
 	for (const auto &[data, flags] : base::take(_updates)) {
-		_stream.fire({ data, flags });
+		fire({ data, flags });
 	}
 }
 
@@ -382,6 +472,7 @@ void Changes::sendNotifications() {
 		return;
 	}
 	_notify = false;
+	const auto started = crl::now();
 	_peerChanges.sendNotifications();
 	_historyChanges.sendNotifications();
 	_messageChanges.sendNotifications();
@@ -389,6 +480,11 @@ void Changes::sendNotifications() {
 	_topicChanges.sendNotifications();
 	_sublistChanges.sendNotifications();
 	_storyChanges.sendNotifications();
+	const auto duration = crl::now() - started;
+	if (duration >= kSlowNotificationsDuration) {
+		DEBUG_LOG(("Data Changes: notifications took %1ms."
+			).arg(duration));
+	}
 }
 
 } // namespace Data
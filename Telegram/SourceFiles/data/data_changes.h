@@ -451,13 +451,38 @@ private:
 	private:
 		static constexpr auto kCount = details::CountBit<Flag>() + 1;
 
+		// Per object listeners grouped by the flags they asked for, so that
+		// an update wakes up only the subscribers of its own object.
+		struct KeyedStream {
+			Flags flags;
+			rpl::event_stream<UpdateType> stream;
+			int subscribers = 0;
+		};
+		struct KeyedListeners {
+			std::unordered_map<
+				not_null<DataType*>,
+				std::vector<std::unique_ptr<KeyedStream>>> streams;
+			std::vector<not_null<DataType*>> cleanup;
+			int dispatching = 0;
+		};
+
 		void sendRealtimeNotifications(
 			not_null<DataType*> data,
 			Flags flags);
+		void fire(const UpdateType &update);
+		static void Unsubscribe(
+			KeyedListeners &keyed,
+			not_null<DataType*> data,
+			not_null<KeyedStream*> stream);
+		static void RemoveUnused(
+			KeyedListeners &keyed,
+			not_null<DataType*> data);
 
 		std::array<rpl::event_stream<UpdateType>, kCount> _realtimeStreams;
 		base::flat_map<not_null<DataType*>, Flags> _updates;
 		rpl::event_stream<UpdateType> _stream;
+		const std::shared_ptr<KeyedListeners> _keyed
+			= std::make_shared<KeyedListeners>();
 
 	};
 
@@ -312,16 +312,6 @@ bool StickerData::isWebm() const {
 	return (type == StickerType::Webm);
 }
 
-VoiceData::~VoiceData() {
-	if (!waveform.isEmpty()
-		&& waveform[0] == -1
-		&& waveform.size() > int32(sizeof(TaskId))) {
-		auto taskId = TaskId();
-		memcpy(&taskId, waveform.constData() + 1, sizeof(taskId));
-		Local::cancelTask(taskId);
-	}
-}
-
 DocumentData::DocumentData(not_null<Data::Session*> owner, DocumentId id)
 : id(id)
 , _owner(owner) {
@@ -90,8 +90,6 @@ struct SongData : public DocumentAdditionalData {
 };
 
 struct VoiceData : public DocumentAdditionalData {
-	~VoiceData();
-
 	VoiceWaveform waveform;
 	char wavemax = 0;
 };
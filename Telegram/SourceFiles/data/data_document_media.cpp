@@ -16,6 +16,7 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 #include "main/main_session_settings.h"
 #include "lottie/lottie_animation.h"
 #include "lottie/lottie_frame_generator.h"
+#include "media/audio/media_audio.h"
 #include "ffmpeg/ffmpeg_frame_generator.h"
 #include "history/history_item.h"
 #include "history/history.h"
@@ -49,6 +50,50 @@ enum class FileType {
 	SvgImage,
 };
 
+// A failed count is cached as well, as a single negative value.
+[[nodiscard]] QByteArray SerializeVoiceWaveform(
+		const VoiceWaveform &waveform) {
+	return waveform.isEmpty()
+		? QByteArray(1, char(-2))
+		: QByteArray(
+			reinterpret_cast<const char*>(waveform.constData()),
+			waveform.size());
+}
+
+[[nodiscard]] VoiceWaveform DeserializeVoiceWaveform(
+		const QByteArray &serialized) {
+	const auto failed = (serialized.size() == 1 && serialized[0] < 0);
+	const auto bad = ranges::any_of(serialized, [](char value) {
+		return (value < 0) || (value > 31);
+	});
+	if (serialized.isEmpty() || (bad && !failed)) {
+		return VoiceWaveform();
+	}
+	auto result = VoiceWaveform(serialized.size());
+	memcpy(result.data(), serialized.constData(), serialized.size());
+	return result;
+}
+
+void ApplyVoiceWaveform(
+		not_null<DocumentData*> document,
+		const VoiceWaveform &waveform) {
+	const auto voice = document->isVideoMessage()
+		? document->round()
+		: document->voice();
+	if (!voice
+		|| (!voice->waveform.isEmpty() && voice->waveform[0] >= 0)) {
+		return;
+	}
+	if (!waveform.isEmpty() && waveform[0] >= 0) {
+		voice->waveform = waveform;
+		voice->wavemax = *ranges::max_element(voice->waveform);
+	} else {
+		voice->waveform = VoiceWaveform(1, -2);
+		voice->wavemax = 0;
+	}
+	document->owner().requestDocumentViewRepaint(document);
+}
+
 [[nodiscard]] bool MayHaveGoodThumbnail(not_null<DocumentData*> owner) {
 	return owner->isVideoFile()
 		|| owner->isAnimation()
@@ -207,6 +252,14 @@ void DocumentMedia::setGoodThumbnail(QImage thumbnail) {
 	_owner->session().notifyDownloaderTaskFinished();
 }
 
+void DocumentMedia::voiceWaveformWanted() {
+	if (_flags & Flag::VoiceWaveformWanted) {
+		return;
+	}
+	_flags |= Flag::VoiceWaveformWanted;
+	ReadOrCountVoiceWaveform(_owner);
+}
+
 Image *DocumentMedia::thumbnailInline() const {
 	if (!_inlineThumbnail && !_owner->inlineThumbnailIsPath()) {
 		const auto bytes = _owner->inlineThumbnailBytes();
@@ -539,6 +592,50 @@ void DocumentMedia::ReadOrGenerateThumbnail(
 	document->owner().cache().get(document->goodThumbnailCacheKey(), got);
 }
 
+void DocumentMedia::ReadOrCountVoiceWaveform(
+		not_null<DocumentData*> document) {
+	const auto guard = base::make_weak(&document->session());
+	const auto got = [=](QByteArray value) {
+		auto waveform = DeserializeVoiceWaveform(value);
+		crl::on_main(guard, [=, waveform = std::move(waveform)] {
+			const auto active = document->activeMediaView();
+			if (!waveform.isEmpty()) {
+				ApplyVoiceWaveform(document, waveform);
+			} else if (active && active->loaded()) {
+				CountVoiceWaveform(document, active->bytes());
+			} else if (active) {
+				// Try once again when the file is loaded.
+				active->_flags &= ~Flag::VoiceWaveformWanted;
+			}
+		});
+	};
+	document->owner().cache().get(
+		Data::AudioWaveformCacheKey(document->id),
+		got);
+}
+
+void DocumentMedia::CountVoiceWaveform(
+		not_null<DocumentData*> document,
+		QByteArray data) {
+	const auto guard = base::make_weak(&document->session());
+	crl::async([=, location = document->location(true)]() mutable {
+		const auto fromFile = data.isEmpty();
+		if (fromFile && !location.accessEnable()) {
+			return;
+		}
+		auto waveform = audioCountWaveform(location, data);
+		if (fromFile) {
+			location.accessDisable();
+		}
+		crl::on_main(guard, [=, waveform = std::move(waveform)] {
+			document->owner().cache().put(
+				Data::AudioWaveformCacheKey(document->id),
+				SerializeVoiceWaveform(waveform));
+			ApplyVoiceWaveform(document, waveform);
+		});
+	});
+}
+
 auto DocumentIconFrameGenerator(not_null<DocumentMedia*> media)
 -> FnMut<std::unique_ptr<Ui::FrameGenerator>()> {
 	if (!media->loaded()) {
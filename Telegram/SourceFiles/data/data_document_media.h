@@ -68,6 +68,8 @@ public:
 	void videoThumbnailWanted(Data::FileOrigin origin);
 	void setVideoThumbnail(QByteArray content);
 
+	void voiceWaveformWanted();
+
 	void checkStickerLarge();
 	void checkStickerSmall();
 	[[nodiscard]] Image *getStickerSmall();
@@ -90,6 +92,7 @@ public:
 private:
 	enum class Flag : uchar {
 		GoodThumbnailWanted = 0x01,
+		VoiceWaveformWanted = 0x02,
 	};
 	inline constexpr bool is_flag_type(Flag) { return true; };
 	using Flags = base::flags<Flag>;
@@ -99,6 +102,11 @@ private:
 		not_null<DocumentData*> document,
 		QByteArray data);
 
+	static void ReadOrCountVoiceWaveform(not_null<DocumentData*> document);
+	static void CountVoiceWaveform(
+		not_null<DocumentData*> document,
+		QByteArray data);
+
 	[[nodiscard]] bool thumbnailEnoughForSticker() const;
 
 	// NB! Right now DocumentMedia can outlive Main::Session!
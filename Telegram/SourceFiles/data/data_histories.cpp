@@ -39,6 +39,8 @@ namespace {
 
 constexpr auto kReadRequestTimeout = 3 * crl::time(1000);
 constexpr auto kReportDeliveriesPerRequest = 50;
+constexpr auto kAcknowledgementsDelay = crl::time(100);
+constexpr auto kAcknowledgementsMaxDelay = crl::time(1000);
 
 } // namespace
 
@@ -134,7 +136,8 @@ MTPInputMedia WebPageForMTP(
 
 Histories::Histories(not_null<Session*> owner)
 : _owner(owner)
-, _readRequestsTimer([=] { sendReadRequests(); }) {
+, _readRequestsTimer([=] { scheduleAcknowledgements(); })
+, _acknowledgementsTimer([=] { flushAcknowledgements(); }) {
 }
 
 Session &Histories::owner() const {
@@ -316,7 +319,7 @@ void Histories::readInboxTill(
 			).arg(tillId.bare
 			).arg(stillUnread.value_or(-666)));
 		state.willReadWhen = 0;
-		sendReadRequests();
+		scheduleAcknowledgements();
 		if (!stillUnread) {
 			return;
 		}
@@ -628,21 +631,69 @@ void Histories::sendPendingReadInbox(not_null<History*> history) {
 			).arg(state->willReadWhen));
 		if (state->willReadTill && state->willReadWhen) {
 			state->willReadWhen = 0;
-			sendReadRequests();
+			scheduleAcknowledgements();
 		}
 	}
 }
 
 void Histories::reportDelivery(not_null<HistoryItem*> item) {
 	auto &set = _pendingDeliveryReport[item->history()->peer];
-	if (!set.emplace(item->id).second) {
+	if (set.emplace(item->id).second) {
+		scheduleAcknowledgements();
+	}
+}
+
+void Histories::scheduleAcknowledgements() {
+	if (!_acknowledgementsScheduled) {
+		_acknowledgementsScheduled = crl::now();
+		_acknowledgementsTimer.callOnce(kAcknowledgementsDelay);
+	}
+}
+
+void Histories::flushAcknowledgements() {
+	const auto now = crl::now();
+	const auto waited = now - _acknowledgementsScheduled;
+	if (waited < kAcknowledgementsMaxDelay && historyLoadsInFlight()) {
+		_acknowledgementsTimer.callOnce(kAcknowledgementsDelay);
 		return;
 	}
-	crl::on_main(&session(), [=] {
-		reportPendingDeliveries();
+	_acknowledgementsScheduled = 0;
+	_acknowledgementsFlushLatency = waited;
+	DEBUG_LOG(("Acknowledgements: flushing %1 after %2 ms."
+		).arg(acknowledgementsQueueDepth()
+		).arg(waited));
+
+	// Sent in one go, so that they're packed in a few containers.
+	sendReadRequests();
+	reportPendingDeliveries();
+}
+
+bool Histories::historyLoadsInFlight() const {
+	const auto loading = [](const auto &pair) {
+		return pair.second.type == RequestType::History;
+	};
+	return ranges::any_of(_states, [&](const auto &pair) {
+		return ranges::any_of(pair.second.sent, loading);
 	});
 }
 
+int Histories::acknowledgementsQueueDepth() const {
+	auto result = 0;
+	for (const auto &[history, state] : _states) {
+		if (state.willReadTill) {
+			++result;
+		}
+	}
+	for (const auto &[peer, ids] : _pendingDeliveryReport) {
+		result += int(ids.size());
+	}
+	return result;
+}
+
+crl::time Histories::acknowledgementsFlushLatency() const {
+	return _acknowledgementsFlushLatency;
+}
+
 void Histories::reportPendingDeliveries() {
 	auto &pending = _pendingDeliveryReport;
 	for (auto i = begin(pending); i != end(pending);) {
@@ -674,7 +725,7 @@ void Histories::reportPendingDeliveries() {
 		const auto finish = [=] {
 			_deliveryReportSent.remove(peer);
 			if (_pendingDeliveryReport.contains(peer)) {
-				reportPendingDeliveries();
+				scheduleAcknowledgements();
 			}
 		};
 		session().api().request(MTPmessages_ReportMessagesDelivery(
@@ -738,7 +789,7 @@ void Histories::sendReadRequest(not_null<History*> history, State &state) {
 				Assert(!state->sentReadTill || state->sentReadTill > tillId);
 			}
 			history->validateMonoAndForumUnread(tillId);
-			sendReadRequests();
+			scheduleAcknowledgements();
 			finish();
 		};
 		if (const auto channel = history->peer->asChannel()) {
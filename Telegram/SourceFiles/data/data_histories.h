@@ -66,6 +66,11 @@ public:
 	void sendPendingReadInbox(not_null<History*> history);
 	void reportDelivery(not_null<HistoryItem*> item);
 
+	// Read and delivery reports waiting to be sent and the time the last
+	// batch of them waited for the history loads to finish.
+	[[nodiscard]] int acknowledgementsQueueDepth() const;
+	[[nodiscard]] crl::time acknowledgementsFlushLatency() const;
+
 	void requestDialogEntry(not_null<Data::Folder*> folder);
 	void requestDialogEntry(
 		not_null<History*> history,
@@ -208,6 +213,9 @@ private:
 
 	void sendDialogRequests();
 	void reportPendingDeliveries();
+	void scheduleAcknowledgements();
+	void flushAcknowledgements();
+	[[nodiscard]] bool historyLoadsInFlight() const;
 
 	[[nodiscard]] bool isCreatingTopic(
 		not_null<History*> history,
@@ -222,6 +230,9 @@ private:
 	base::flat_map<int, not_null<History*>> _historyByRequest;
 	int _requestAutoincrement = 0;
 	base::Timer _readRequestsTimer;
+	base::Timer _acknowledgementsTimer;
+	crl::time _acknowledgementsScheduled = 0;
+	crl::time _acknowledgementsFlushLatency = 0;
 
 	base::flat_set<not_null<Data::Folder*>> _dialogFolderRequests;
 	base::flat_map<
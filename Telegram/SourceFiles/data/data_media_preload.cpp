@@ -36,12 +36,20 @@ MediaPreload::MediaPreload(Fn<void()> done)
 : _done(std::move(done)) {
 }
 
+bool MediaPreload::downloading() const {
+	return _downloading;
+}
+
 void MediaPreload::callDone() {
 	if (const auto onstack = _done) {
 		onstack();
 	}
 }
 
+void MediaPreload::startDownloading() {
+	_downloading = true;
+}
+
 PhotoPreload::PhotoPreload(
 	not_null<PhotoData*> photo,
 	FileOrigin origin,
@@ -71,6 +79,7 @@ void PhotoPreload::start(FileOrigin origin) {
 	if (_photo->loaded()) {
 		callDone();
 	} else {
+		startDownloading();
 		_photo->owner()->load(origin, LoadFromCloudOrLocal, true);
 		_photo->owner()->session().downloaderTaskFinished(
 		) | rpl::filter([=] {
@@ -130,6 +139,7 @@ void VideoPreload::load() {
 	for (auto i = 0; i != parts; ++i) {
 		_parts.emplace(i * part, QByteArray());
 	}
+	startDownloading();
 	addToQueue();
 }
 
@@ -156,6 +166,10 @@ bool VideoPreload::Can(not_null<DocumentData*> video) {
 		&& video->bigFileBaseCacheKey();
 }
 
+int64 VideoPreload::PrefixSize(not_null<DocumentData*> video) {
+	return ChoosePreloadPrefix(video);
+}
+
 bool VideoPreload::readyToRequest() const {
 	const auto part = Storage::kDownloadPartSize;
 	return !_failed && (_nextRequestOffset < _parts.size() * part);
@@ -19,11 +19,16 @@ public:
 	explicit MediaPreload(Fn<void()> done);
 	virtual ~MediaPreload() = default;
 
+	// False while the media is looked up locally or if it was found.
+	[[nodiscard]] bool downloading() const;
+
 protected:
 	void callDone();
+	void startDownloading();
 
 private:
 	Fn<void()> _done;
+	bool _downloading = false;
 
 };
 
@@ -52,6 +57,7 @@ class VideoPreload final
 	, private Storage::DownloadMtprotoTask {
 public:
 	[[nodiscard]] static bool Can(not_null<DocumentData*> video);
+	[[nodiscard]] static int64 PrefixSize(not_null<DocumentData*> video);
 
 	VideoPreload(
 		not_null<DocumentData*> video,
@@ -43,6 +43,13 @@ constexpr auto kSavedFirstPerPage = 30;
 constexpr auto kSavedPerPage = 100;
 constexpr auto kMaxPreloadSources = 10;
 constexpr auto kStillPreloadFromFirst = 3;
+constexpr auto kPreloadBudget = 64 * 1024 * 1024;
+constexpr auto kPreloadBudgetPeriod = 10 * 60 * crl::time(1000);
+constexpr auto kViewerBehaviorWeight = 0.2;
+constexpr auto kViewerDefaultDwell = 5 * crl::time(1000);
+constexpr auto kViewerPreloadAhead = 10 * crl::time(1000);
+constexpr auto kViewerPreloadNextMax = 5;
+constexpr auto kViewerLeavesSource = 0.5;
 constexpr auto kMaxSegmentsCount = 180;
 constexpr auto kPollingIntervalChat = 5 * TimeId(60);
 constexpr auto kPollingIntervalViewer = 1 * TimeId(60);
@@ -191,7 +198,8 @@ Stories::Stories(not_null<Session*> owner)
 , _markReadTimer([=] { sendMarkAsReadRequests(); })
 , _incrementViewsTimer([=] { sendIncrementViewsRequests(); })
 , _pollingTimer([=] { sendPollingRequests(); })
-, _pollingViewsTimer([=] { sendPollingViewsRequests(); }) {
+, _pollingViewsTimer([=] { sendPollingViewsRequests(); })
+, _preloadBudgetTimer([=] { continuePreloading(); }) {
 	crl::on_main(this, [=] {
 		session().changes().peerUpdates(
 			Data::PeerUpdate::Flag::Rights
@@ -606,7 +614,7 @@ Story *Stories::parseAndApply(
 		if (mediaChanged) {
 			_preloaded.remove(fullId);
 			if (_preloading && _preloading->id() == fullId) {
-				_preloading = nullptr;
+				resetPreloading();
 				rebuildPreloadSources(StorySourcesList::NotHidden);
 				rebuildPreloadSources(StorySourcesList::Hidden);
 				continuePreloading();
@@ -971,7 +979,7 @@ void Stories::applyDeleted(not_null<PeerData*> peer, StoryId id) {
 				removeFromAlbum(id);
 			}
 			if (_preloading && _preloading->id() == fullId) {
-				_preloading = nullptr;
+				resetPreloading();
 				preloadFinished(fullId);
 			}
 			_owner->refreshStoryItemViews(fullId);
@@ -2364,6 +2372,27 @@ void Stories::setPreloadingInViewer(std::vector<FullStoryId> ids) {
 	}
 }
 
+void Stories::viewerStoryLeft(crl::time dwell, bool sourceLeft) {
+	if (!_viewerDwell) {
+		_viewerDwell = kViewerDefaultDwell;
+	}
+	_viewerDwell += (dwell - _viewerDwell) * kViewerBehaviorWeight;
+	_viewerLeaveRate += ((sourceLeft ? 1. : 0.) - _viewerLeaveRate)
+		* kViewerBehaviorWeight;
+}
+
+StoriesViewerPreload Stories::viewerPreload() const {
+	// Preload as many stories as the user is expected to watch soon,
+	// or the next source if the user usually skips to it.
+	if (_viewerLeaveRate >= kViewerLeavesSource) {
+		return { .next = 1, .nextSource = true };
+	}
+	const auto dwell = _viewerDwell ? _viewerDwell : kViewerDefaultDwell;
+	const auto next = int(std::ceil(
+		kViewerPreloadAhead / std::max(dwell, 1.)));
+	return { .next = std::clamp(next, 1, kViewerPreloadNextMax) };
+}
+
 std::optional<Stories::PeerSourceState> Stories::peerSourceState(
 		not_null<PeerData*> peer,
 		const MTPRecentStory &recent) {
@@ -2595,16 +2624,32 @@ void Stories::continuePreloading() {
 		if (shouldContinuePreload(now)) {
 			return;
 		}
-		_preloading = nullptr;
+		resetPreloading();
 	}
 	const auto id = nextPreloadId();
 	if (!id) {
 		return;
+	} else if (!ranges::contains(_toPreloadViewer, id)
+		&& !preloadBudgetLeft()) {
+		_preloadBudgetTimer.callOnce(std::max(
+			_preloadBudgetStarted + kPreloadBudgetPeriod - crl::now(),
+			crl::time(1)));
+		return;
 	} else if (const auto maybeStory = lookup(id)) {
 		startPreloading(*maybeStory);
 	}
 }
 
+bool Stories::preloadBudgetLeft() {
+	const auto now = crl::now();
+	if (!_preloadBudgetStarted
+		|| now - _preloadBudgetStarted >= kPreloadBudgetPeriod) {
+		_preloadBudgetStarted = now;
+		_preloadBudgetSpent = 0;
+	}
+	return (_preloadBudgetSpent < kPreloadBudget);
+}
+
 bool Stories::shouldContinuePreload(FullStoryId id) const {
 	const auto first = ranges::views::concat(
 		_toPreloadViewer,
@@ -2633,8 +2678,9 @@ void Stories::startPreloading(not_null<Story*> story) {
 	Expects(!_preloaded.contains(story->fullId()));
 
 	const auto id = story->fullId();
+	_preloadingFromSources = !ranges::contains(_toPreloadViewer, id);
 	auto preloading = std::make_unique<StoryPreload>(story, [=] {
-		_preloading = nullptr;
+		resetPreloading();
 		preloadFinished(id, true);
 	});
 	if (!_preloaded.contains(id)) {
@@ -2642,6 +2688,17 @@ void Stories::startPreloading(not_null<Story*> story) {
 	}
 }
 
+void Stories::resetPreloading() {
+	// Only the source lists preloads are limited, by the bytes they
+	// download, stories found in the cache are not charged.
+	const auto preloading = base::take(_preloading);
+	if (preloading
+		&& _preloadingFromSources
+		&& preloading->downloading()) {
+		_preloadBudgetSpent += preloading->bytes();
+	}
+}
+
 void Stories::preloadFinished(FullStoryId id, bool markAsPreloaded) {
 	for (auto &sources : _toPreloadSources) {
 		sources.erase(ranges::remove(sources, id), end(sources));
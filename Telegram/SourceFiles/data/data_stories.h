@@ -137,6 +137,11 @@ struct StoryAlbumUpdate {
 	std::vector<StoryId> removed;
 };
 
+struct StoriesViewerPreload {
+	int next = 0;
+	bool nextSource = false;
+};
+
 inline constexpr auto kStorySourcesListCount = 2;
 
 struct StoryAlbumIdsKey {
@@ -269,6 +274,8 @@ public:
 	void incrementPreloadingHiddenSources();
 	void decrementPreloadingHiddenSources();
 	void setPreloadingInViewer(std::vector<FullStoryId> ids);
+	void viewerStoryLeft(crl::time dwell, bool sourceLeft);
+	[[nodiscard]] StoriesViewerPreload viewerPreload() const;
 
 	struct PeerSourceState {
 		StoryId maxId = 0;
@@ -379,7 +386,9 @@ private:
 	void continuePreloading();
 	[[nodiscard]] bool shouldContinuePreload(FullStoryId id) const;
 	[[nodiscard]] FullStoryId nextPreloadId() const;
+	[[nodiscard]] bool preloadBudgetLeft();
 	void startPreloading(not_null<Story*> story);
+	void resetPreloading();
 	void preloadFinished(FullStoryId id, bool markAsPreloaded = false);
 	void preloadListsMore();
 
@@ -474,6 +483,12 @@ private:
 	std::unique_ptr<StoryPreload> _preloading;
 	int _preloadingHiddenSourcesCounter = 0;
 	int _preloadingMainSourcesCounter = 0;
+	int64 _preloadBudgetSpent = 0;
+	crl::time _preloadBudgetStarted = 0;
+	base::Timer _preloadBudgetTimer;
+	bool _preloadingFromSources = false;
+	float64 _viewerDwell = 0.;
+	float64 _viewerLeaveRate = 0.;
 
 	base::flat_map<PeerId, StoryId> _readTill;
 	base::flat_set<FullStoryId> _pendingReadTillItems;
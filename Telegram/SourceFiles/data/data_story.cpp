@@ -936,6 +936,7 @@ StoryPreload::StoryPreload(not_null<Story*> story, Fn<void()> done)
 : _story(story) {
 	if (const auto photo = _story->photo()) {
 		if (PhotoPreload::Should(photo, story->peer())) {
+			_bytes = photo->imageByteSize(PhotoSize::Large);
 			_task = std::make_unique<PhotoPreload>(
 				photo,
 				story->fullId(),
@@ -945,6 +946,7 @@ StoryPreload::StoryPreload(not_null<Story*> story, Fn<void()> done)
 		}
 	} else if (const auto video = _story->document()) {
 		if (VideoPreload::Can(video)) {
+			_bytes = VideoPreload::PrefixSize(video);
 			_task = std::make_unique<VideoPreload>(
 				video,
 				story->fullId(),
@@ -967,4 +969,12 @@ not_null<Story*> StoryPreload::story() const {
 	return _story;
 }
 
+int64 StoryPreload::bytes() const {
+	return _bytes;
+}
+
+bool StoryPreload::downloading() const {
+	return _task && _task->downloading();
+}
+
 } // namespace Data
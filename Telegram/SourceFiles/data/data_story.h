@@ -308,11 +308,14 @@ public:
 
 	[[nodiscard]] FullStoryId id() const;
 	[[nodiscard]] not_null<Story*> story() const;
+	[[nodiscard]] int64 bytes() const;
+	[[nodiscard]] bool downloading() const;
 
 private:
 	const not_null<Story*> _story;
 
 	std::unique_ptr<MediaPreload> _task;
+	int64 _bytes = 0;
 
 };
 
@@ -20,6 +20,7 @@ constexpr auto kDocumentCacheMask = 0x00000000000000FFULL;
 constexpr auto kDocumentThumbCacheTag = 0x0000000000000200ULL;
 constexpr auto kDocumentThumbCacheMask = 0x00000000000000FFULL;
 constexpr auto kAudioAlbumThumbCacheTag = 0x0000000000000300ULL;
+constexpr auto kAudioWaveformCacheTag = 0x0000000000000400ULL;
 constexpr auto kWebDocumentCacheTag = 0x0000020000000000ULL;
 constexpr auto kUrlCacheTag = 0x0000030000000000ULL;
 constexpr auto kGeoPointCacheTag = 0x0000040000000000ULL;
@@ -96,6 +97,13 @@ Storage::Cache::Key AudioAlbumThumbCacheKey(
 	};
 }
 
+Storage::Cache::Key AudioWaveformCacheKey(uint64 documentId) {
+	return Storage::Cache::Key{
+		Data::kAudioWaveformCacheTag,
+		documentId,
+	};
+}
+
 } // namespace Data
 
 void MessageCursor::fillFrom(not_null<const Ui::InputField*> field) {
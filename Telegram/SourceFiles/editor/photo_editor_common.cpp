@@ -12,6 +12,8 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 #include "ui/painter.h"
 #include "ui/userpic_view.h"
 
+#include <QtGui/QPainterPath>
+
 namespace Editor {
 namespace {
 
@@ -39,25 +41,26 @@ void ApplyShapeMask(QImage &image, const PhotoModifications &mods) {
 	if (image.format() != QImage::Format_ARGB32_Premultiplied) {
 		image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
 	}
-	auto mask = QImage(image.size(), QImage::Format_ARGB32_Premultiplied);
-	mask.fill(Qt::transparent);
-	{
-		auto p = QPainter(&mask);
-		auto hq = PainterHighQualityEnabler(p);
-		p.setPen(Qt::NoPen);
-		p.setBrush(Qt::white);
-		const auto rect = QRectF(QPointF(), QSizeF(image.size()));
-		if (type == EditorData::CropType::Ellipse) {
-			p.drawEllipse(rect);
-		} else {
-			const auto radius = std::min(rect.width(), rect.height())
-				* multiplier;
-			p.drawRoundedRect(rect, radius, radius);
-		}
+
+	// Clear everything outside of the shape in place, without allocating
+	// a mask of the same size as the (possibly huge) image.
+	const auto rect = QRectF(QPointF(), QSizeF(image.size()));
+	auto shape = QPainterPath();
+	if (type == EditorData::CropType::Ellipse) {
+		shape.addEllipse(rect);
+	} else {
+		const auto radius = std::min(rect.width(), rect.height())
+			* multiplier;
+		shape.addRoundedRect(rect, radius, radius);
 	}
+	auto outside = QPainterPath();
+	outside.addRect(rect);
+	outside = outside.subtracted(shape);
+
 	auto p = QPainter(&image);
-	p.setCompositionMode(QPainter::CompositionMode_DestinationIn);
-	p.drawImage(0, 0, mask);
+	auto hq = PainterHighQualityEnabler(p);
+	p.setCompositionMode(QPainter::CompositionMode_Clear);
+	p.fillPath(outside, Qt::black);
 }
 
 float64 RoundedCornersMultiplier(RoundedCornersLevel level) {
@@ -76,28 +79,35 @@ QImage ImageModified(QImage image, const PhotoModifications &mods) {
 	if (!mods) {
 		return image;
 	}
+	// Crop before painting, so that only the part being sent is converted
+	// and painted over, the rest of a large photo is never touched.
+	const auto full = image.rect();
+	const auto crop = mods.crop.isValid() ? mods.crop : full;
+	auto cropped = (crop != full) ? image.copy(crop) : std::move(image);
 	if (mods.paint) {
-		if (image.format() != QImage::Format_ARGB32_Premultiplied) {
-			image = image.convertToFormat(
+		if (cropped.format() != QImage::Format_ARGB32_Premultiplied) {
+			cropped = cropped.convertToFormat(
 				QImage::Format_ARGB32_Premultiplied);
 		}
+		const auto visible = crop.intersected(full);
+		if (!visible.isEmpty()) {
+			Painter p(&cropped);
+			PainterHighQualityEnabler hq(p);
 
-		Painter p(&image);
-		PainterHighQualityEnabler hq(p);
-
-		mods.paint->render(&p, image.rect());
-	}
-	auto cropped = mods.crop.isValid()
-		? image.copy(mods.crop)
-		: image;
-	QTransform transform;
-	if (mods.flipped) {
-		transform.scale(-1, 1);
+			// Same mapping as rendering the scene over the full image.
+			p.translate(-crop.topLeft());
+			p.setClipRect(visible);
+			mods.paint->render(&p, full);
+		}
 	}
 	if (mods.angle) {
+		auto transform = QTransform();
 		transform.rotate(mods.angle);
+		cropped = cropped.transformed(transform);
 	}
-	return cropped.transformed(transform);
+	return mods.flipped
+		? std::move(cropped).mirrored(true, false)
+		: cropped;
 }
 
 Media::Encode::Job ComposeAnimatedJob(
@@ -24,6 +24,55 @@ constexpr auto kDotDuration = crl::time(500);
 // Frames are scaled on paint, so small width drift needs no re-extract.
 constexpr auto kFrameWidthTolerance = 0.25;
 
+constexpr auto kExtractThreads = 3;
+constexpr auto kCachedFiles = 4;
+constexpr auto kCachedFramesPerFile = 256;
+
+// Frames of the recently edited files by requested position, they are
+// reused when the timeline is resized or the editor is opened again.
+struct CachedFrames {
+	QString path;
+	int height = 0;
+	base::flat_map<crl::time, QImage> frames;
+	std::deque<crl::time> order;
+};
+
+[[nodiscard]] CachedFrames &CachedFramesFor(const QString &path, int height) {
+	static auto cache = std::vector<CachedFrames>();
+
+	const auto i = ranges::find_if(cache, [&](const CachedFrames &entry) {
+		return (entry.path == path) && (entry.height == height);
+	});
+	if (i != end(cache)) {
+		std::rotate(begin(cache), i, i + 1);
+	} else {
+		if (int(cache.size()) >= kCachedFiles) {
+			cache.pop_back();
+		}
+		cache.insert(begin(cache), CachedFrames{
+			.path = path,
+			.height = height,
+		});
+	}
+	return cache.front();
+}
+
+void CacheFrame(
+		const QString &path,
+		int height,
+		crl::time position,
+		const QImage &frame) {
+	auto &cached = CachedFramesFor(path, height);
+	if (!cached.frames.emplace(position, frame).second) {
+		return;
+	}
+	cached.order.push_back(position);
+	if (int(cached.order.size()) > kCachedFramesPerFile) {
+		cached.frames.remove(cached.order.front());
+		cached.order.pop_front();
+	}
+}
+
 } // namespace
 
 VideoTimeline::VideoTimeline(
@@ -173,37 +222,75 @@ void VideoTimeline::reloadFrames() {
 	_framesBox = QSize(frameWidth, height);
 	_frames = std::vector<QImage>(count);
 
+	// Frames keep the video aspect and are cropped to the slot on paint,
+	// so any cached frame inside the slot time span fits it.
+	const auto path = _descriptor.path;
+	const auto ratio = style::DevicePixelRatio();
+	const auto box = QSize(aspectWidth, height) * ratio;
+	const auto &cached = CachedFramesFor(path, box.height()).frames;
 	auto positions = std::vector<crl::time>();
-	positions.reserve(count);
+	auto slots = std::vector<int>();
 	for (auto i = 0; i != count; ++i) {
+		const auto from = i * _duration / count;
+		const auto till = (i + 1) * _duration / count;
+		const auto j = cached.lower_bound(from);
+		if (j != end(cached) && j->first < till) {
+			_frames[i] = j->second;
+			continue;
+		}
 		positions.push_back(crl::time(
 			base::SafeRound((i + 0.5) * _duration / count)));
+		slots.push_back(i);
+	}
+	if (positions.empty()) {
+		_framesCancel = nullptr;
+		return;
 	}
 	const auto cancel = std::make_shared<std::atomic<bool>>(false);
 	_framesCancel = cancel;
 
-	const auto path = _descriptor.path;
-	const auto box = _framesBox * style::DevicePixelRatio();
-	crl::async([=, weak = base::make_weak(this)] {
-		Media::Video::ExtractFrames(path, {
-			.positions = positions,
+	// Interleave the positions between the extractors to fill the strip
+	// evenly, each of them has its own demuxer and decoder.
+	const auto missing = int(positions.size());
+	const auto threads = std::min(missing, kExtractThreads);
+	for (auto thread = 0; thread != threads; ++thread) {
+		auto request = Media::Video::ExtractRequest{
 			.box = box,
-			.cover = true,
-		}, [&](int index, QImage &&frame) {
-			if (cancel->load()) {
-				return false;
-			}
-			frame.setDevicePixelRatio(style::DevicePixelRatio());
-			crl::on_main(weak, [=, frame = std::move(frame)]() mutable {
-				if (cancel->load() || index >= int(_frames.size())) {
-					return;
+			.keyframeTolerance = _duration / (count * 2),
+		};
+		auto requestSlots = std::vector<int>();
+		for (auto k = thread; k < missing; k += threads) {
+			request.positions.push_back(positions[k]);
+			requestSlots.push_back(slots[k]);
+		}
+		crl::async([
+				=,
+				weak = base::make_weak(this),
+				request = std::move(request),
+				requestSlots = std::move(requestSlots)] {
+			Media::Video::ExtractFrames(path, request, [&](
+					int index,
+					QImage &&frame) {
+				if (cancel->load()) {
+					return false;
+				} else if (frame.isNull()) {
+					return true;
 				}
-				_frames[index] = std::move(frame);
-				update();
+				frame.setDevicePixelRatio(ratio);
+				const auto slot = requestSlots[index];
+				const auto position = request.positions[index];
+				crl::on_main(weak, [=, frame = std::move(frame)]() mutable {
+					CacheFrame(path, box.height(), position, frame);
+					if (cancel->load() || slot >= int(_frames.size())) {
+						return;
+					}
+					_frames[slot] = std::move(frame);
+					update();
+				});
+				return true;
 			});
-			return true;
 		});
-	});
+	}
 }
 
 VideoTimeline::Grab VideoTimeline::grabAt(QPoint position) const {
@@ -380,7 +467,18 @@ void VideoTimeline::paintFrames(QPainter &p, const QRect &strip) {
 			continue;
 		}
 		const auto x = strip.x() + i * strip.width() / count;
-		p.drawImage(QRect(x, strip.y(), _frameWidth, strip.height()), frame);
+		const auto size = frame.size();
+		const auto source = QSize(_frameWidth, strip.height()).scaled(
+			size,
+			Qt::KeepAspectRatio);
+		p.drawImage(
+			QRect(x, strip.y(), _frameWidth, strip.height()),
+			frame,
+			QRect(
+				QPoint(
+					(size.width() - source.width()) / 2,
+					(size.height() - source.height()) / 2),
+				source));
 	}
 }
 
@@ -208,6 +208,14 @@ bool History::hasPendingResizedItems() const {
 	return _flags & Flag::HasPendingResizedItems;
 }
 
+bool History::hasDeferredResize() const {
+	return _flags & Flag::HasDeferredResize;
+}
+
+int History::lastResizedElements() const {
+	return _lastResizedElements;
+}
+
 void History::setHasPendingResizedItems() {
 	_flags |= Flag::HasPendingResizedItems;
 }
@@ -3844,25 +3852,118 @@ HistoryItem *History::lastEditableMessage() const {
 	return nullptr;
 }
 
-void History::resizeToWidth(int newWidth) {
+void History::resizeToWidth(
+		int newWidth,
+		crl::time budget,
+		int visibleHeight) {
 	using Request = HistoryBlock::ResizeRequest;
 	const auto request = (_flags & Flag::PendingAllItemsResize)
 		? Request::ReinitAll
 		: (_width != newWidth)
 		? Request::ResizeAll
 		: Request::ResizePending;
-	if (request == Request::ResizePending && !hasPendingResizedItems()) {
+	if (request == Request::ResizePending
+		&& !hasPendingResizedItems()
+		&& !hasDeferredResize()) {
 		return;
 	}
-	_flags &= ~(Flag::HasPendingResizedItems | Flag::PendingAllItemsResize);
-
+	_flags &= ~(Flag::HasPendingResizedItems
+		| Flag::PendingAllItemsResize
+		| Flag::HasDeferredResize);
+
+	// Blocks laid out for another width are resized while the budget
+	// lasts, nearest to the viewport first, except the ones intersecting
+	// the viewport, which are always resized. The others keep their
+	// heights as estimates for now, only their new messages are laid out,
+	// still for the previous width.
+	const auto started = crl::now();
+	const auto deadline = budget ? (started + budget) : crl::time(0);
+	const auto count = int(blocks.size());
+	const auto stale = [&](int index) {
+		const auto width = blocks[index]->width();
+		return (request != Request::ReinitAll)
+			&& width
+			&& (width != newWidth);
+	};
+	auto laidOut = std::vector<bool>(count);
+	const auto layout = [&](int index) {
+		const auto &block = blocks[index];
+		if (!laidOut[index]) {
+			block->resizeGetHeight(
+				newWidth,
+				stale(index) ? Request::ResizeAll : request);
+			laidOut[index] = true;
+		}
+		return block->height();
+	};
+	_lastResizedElements = 0;
 	_width = newWidth;
+	if (deadline && count) {
+		auto from = count;
+		auto till = count;
+		if (scrollTopItem) {
+			const auto anchor = scrollTopItem->block()->indexInHistory();
+			const auto height = layout(anchor);
+
+			// Viewport top relative to the anchor block top.
+			const auto top = scrollTopItem->y() + scrollTopOffset;
+			from = anchor;
+			till = anchor + 1;
+			auto below = height - top;
+			while (below < visibleHeight && till < count) {
+				below += layout(till++);
+			}
+			auto above = std::max(-top, 0)
+				+ std::max(visibleHeight - below, 0);
+			while (above > 0 && from > 0) {
+				above -= layout(--from);
+			}
+		} else {
+			// Either scrolled to the bottom or the viewport is in the
+			// migrated history above, so both ends may be visible.
+			auto above = std::max(visibleHeight, 1);
+			while (above > 0 && from > 0) {
+				above -= layout(--from);
+			}
+			auto below = visibleHeight;
+			for (auto i = 0; below > 0 && i < from; ++i) {
+				below -= layout(i);
+			}
+		}
+		for (auto up = true
+			; (from > 0 || till < count) && crl::now() < deadline
+			; up = !up) {
+			if ((up && from > 0) || till == count) {
+				layout(--from);
+			} else {
+				layout(till++);
+			}
+		}
+	}
 	int y = 0;
-	for (const auto &block : blocks) {
+	for (auto i = 0; i != count; ++i) {
+		const auto &block = blocks[i];
 		block->setY(y);
-		y += block->resizeGetHeight(newWidth, request);
+		if (laidOut[i] || !deadline || !stale(i)) {
+			y += layout(i);
+		} else {
+			y += block->resizeGetHeight(
+				block->width(),
+				Request::ResizePending);
+			_flags |= Flag::HasDeferredResize;
+		}
 	}
 	_height = y;
+
+	const auto elapsed = crl::now() - started;
+	if (hasDeferredResize() || (budget && elapsed > budget)) {
+		DEBUG_LOG(("History Resize: %1 elements resized for %2 in %3 ms, "
+			"deferred: %4"
+			).arg(_lastResizedElements
+			).arg(newWidth
+			).arg(elapsed
+			).arg(Logs::b(hasDeferredResize())));
+	}
 }
 
 void History::forceFullResize() {
@@ -4615,25 +4716,32 @@ HistoryBlock::HistoryBlock(not_null<History*> history)
 
 int HistoryBlock::resizeGetHeight(int newWidth, ResizeRequest request) {
 	auto y = 0;
+	auto &resized = _history->_lastResizedElements;
 	if (request == ResizeRequest::ReinitAll) {
 		for (const auto &message : messages) {
 			message->setY(y);
 			message->initDimensions();
 			y += message->resizeGetHeight(newWidth);
 		}
+		resized += int(messages.size());
 	} else if (request == ResizeRequest::ResizeAll) {
 		for (const auto &message : messages) {
 			message->setY(y);
 			y += message->resizeGetHeight(newWidth);
 		}
+		resized += int(messages.size());
 	} else {
 		for (const auto &message : messages) {
 			message->setY(y);
-			y += message->pendingResize()
-				? message->resizeGetHeight(newWidth)
-				: message->height();
+			if (message->pendingResize()) {
+				y += message->resizeGetHeight(newWidth);
+				++resized;
+			} else {
+				y += message->height();
+			}
 		}
 	}
+	_width = newWidth;
 	_height = y;
 	return _height;
 }
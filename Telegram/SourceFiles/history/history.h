@@ -285,9 +285,18 @@ public:
 	MsgId msgIdForRead() const;
 	HistoryItem *lastEditableMessage() const;
 
-	void resizeToWidth(int newWidth);
+	// With a positive budget only the blocks intersecting the viewport,
+	// found by scrollTopItem and visibleHeight, are resized right away,
+	// the rest keep their previous layout until the next passes, each
+	// limited by the budget.
+	void resizeToWidth(
+		int newWidth,
+		crl::time budget = 0,
+		int visibleHeight = 0);
 	void forceFullResize();
 	int height() const;
+	[[nodiscard]] bool hasDeferredResize() const;
+	[[nodiscard]] int lastResizedElements() const;
 
 	void itemRemoved(not_null<HistoryItem*> item);
 	void itemVanished(not_null<HistoryItem*> item);
@@ -532,6 +541,7 @@ private:
 		ResolveChatListMessage = (1 << 7),
 		MonoAndForumUnreadInvalidatePending = (1 << 8),
 		HasGuestChatBotMessages = (1 << 9),
+		HasDeferredResize = (1 << 10),
 	};
 	using Flags = base::flags<Flag>;
 	friend inline constexpr auto is_flag_type(Flag) {
@@ -671,6 +681,7 @@ private:
 	Flags _flags = 0;
 	int _width = 0;
 	int _height = 0;
+	int _lastResizedElements = 0;
 	Element *_unreadBarView = nullptr;
 	Element *_firstUnreadView = nullptr;
 	HistoryItem *_joinedMessage = nullptr;
@@ -759,6 +770,9 @@ public:
 	int height() const {
 		return _height;
 	}
+	int width() const {
+		return _width;
+	}
 	not_null<History*> history() const {
 		return _history;
 	}
@@ -792,6 +806,7 @@ protected:
 	const not_null<History*> _history;
 
 	int _y = 0;
+	int _width = 0;
 	int _height = 0;
 	int _indexInHistory = -1;
 
@@ -155,6 +155,8 @@ constexpr auto kScrollDateHideTimeout = 1000;
 constexpr auto kScrollDateHideOnDayCrossingTimeout = crl::time(3000);
 constexpr auto kUnloadHeavyPartsPages = 2;
 constexpr auto kClearUserpicsAfter = 50;
+constexpr auto kDeferredResizeBudget = crl::time(8);
+constexpr auto kDeferredResizeDelay = crl::time(16);
 
 // Helper binary search for an item in a list that is not completely
 // above the given top of the visible area or below the given bottom of the visible area
@@ -411,7 +413,8 @@ HistoryInner::HistoryInner(
 	[=] { mouseActionUpdate(QCursor::pos()); setCursor(_cursor); },
 	[=] { return window()->isActiveWindow(); })
 , _scrollDateCheck([this] { scrollDateCheck(); })
-, _scrollDateHideTimer([this] { scrollDateHideByTimer(); }) {
+, _scrollDateHideTimer([this] { scrollDateHideByTimer(); })
+, _deferredResizeTimer([=] { _widget->updateHistoryGeometry(); }) {
 	_history->delegateMixin()->setCurrent(this);
 	if (_migrated) {
 		_migrated->delegateMixin()->setCurrent(this);
@@ -5014,9 +5017,15 @@ void HistoryInner::recountHistoryGeometry(bool initial) {
 
 	updateBotInfo(false);
 
-	_history->resizeToWidth(_contentWidth);
+	// Far from the scroll position the new layout is finished in slices.
+	const auto budget = initial ? crl::time(0) : kDeferredResizeBudget;
+	_history->resizeToWidth(_contentWidth, budget, visibleHeight);
 	if (_migrated) {
-		_migrated->resizeToWidth(_contentWidth);
+		_migrated->resizeToWidth(_contentWidth, budget, visibleHeight);
+	}
+	if (_history->hasDeferredResize()
+		|| (_migrated && _migrated->hasDeferredResize())) {
+		_deferredResizeTimer.callOnce(kDeferredResizeDelay);
 	}
 
 	_historySkipHeight = 0;
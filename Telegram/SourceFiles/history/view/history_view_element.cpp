@@ -74,6 +74,9 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 #include "styles/style_dialogs.h"
 #include "styles/style_iv.h"
 
+#include <list>
+#include <xxhash.h>
+
 namespace HistoryView {
 namespace {
 
@@ -99,6 +102,9 @@ namespace {
 // A new message from the same sender is attached to previous within 15 minutes.
 constexpr int kAttachMessageToPreviousSecondsDelta = 900;
 constexpr auto kMaxShownLine = 1024 * 1024;
+constexpr auto kTextSizesCacheLimit = 8192;
+constexpr auto kTextSizesRecentWidths = 8;
+constexpr auto kTextSizesStableWidthDelay = crl::time(300);
 
 Element *HoveredElement/* = nullptr*/;
 Element *PressedElement/* = nullptr*/;
@@ -510,6 +516,125 @@ int KeyboardStyle::minButtonWidth(
 	return result;
 }
 
+[[nodiscard]] uint64 TextContentKey(
+		const TextWithEntities &text,
+		const style::TextStyle &st,
+		const TextParseOptions &options) {
+	auto serialized = QByteArray();
+	auto stream = QDataStream(&serialized, QIODevice::WriteOnly);
+	stream
+		<< qint32(st.font->height)
+		<< qint32(options.flags)
+		<< qint32(options.dir)
+		<< text.text;
+	for (const auto &entity : text.entities) {
+		stream
+			<< qint32(entity.type())
+			<< qint32(entity.offset())
+			<< qint32(entity.length())
+			<< entity.data();
+	}
+	const auto result = XXH64(serialized.constData(), serialized.size(), 0);
+	return result ? result : 1;
+}
+
+[[nodiscard]] uint64 TextLayoutKey(uint64 content, int width, int height) {
+	const auto skip = std::array<int32, 2>{ width, height };
+	const auto result = XXH64(skip.data(), sizeof(skip), content);
+	return result ? result : 1;
+}
+
+using TextSizeKey = std::pair<uint64, int>;
+
+struct TextSizeKeyHash {
+	[[nodiscard]] size_t operator()(const TextSizeKey &key) const {
+		// The content part is a hash already.
+		return size_t(key.first ^ (uint64(uint32(key.second)) << 32));
+	}
+};
+
+// Text sizes by text content and width, shared between the views of the
+// same message in the chat, its sections, search results and previews.
+class TextSizesCache final {
+public:
+	[[nodiscard]] const QSize *find(const TextSizeKey &key);
+	void store(const TextSizeKey &key, QSize size);
+
+	// While the window is resized the width changes every frame, so the
+	// sizes are stored only for widths used for some time already.
+	[[nodiscard]] bool stableWidth(int width);
+
+private:
+	struct WidthUse {
+		crl::time first = 0;
+		crl::time last = 0;
+	};
+	using Entries = std::list<std::pair<TextSizeKey, QSize>>;
+
+	Entries _lru;
+	std::unordered_map<
+		TextSizeKey,
+		Entries::iterator,
+		TextSizeKeyHash> _entries;
+	base::flat_map<int, WidthUse> _widths;
+
+};
+
+const QSize *TextSizesCache::find(const TextSizeKey &key) {
+	const auto i = _entries.find(key);
+	if (i == end(_entries)) {
+		return nullptr;
+	}
+	_lru.splice(end(_lru), _lru, i->second);
+	return &i->second->second;
+}
+
+void TextSizesCache::store(const TextSizeKey &key, QSize size) {
+	if (_entries.size() >= kTextSizesCacheLimit) {
+		_entries.erase(_lru.front().first);
+		_lru.pop_front();
+	}
+	_lru.emplace_back(key, size);
+	_entries.emplace(key, std::prev(end(_lru)));
+}
+
+bool TextSizesCache::stableWidth(int width) {
+	const auto now = crl::now();
+	if (const auto i = _widths.find(width); i != end(_widths)) {
+		i->second.last = now;
+		return (now - i->second.first >= kTextSizesStableWidthDelay);
+	} else if (_widths.size() >= kTextSizesRecentWidths) {
+		_widths.erase(ranges::min_element(
+			_widths,
+			ranges::less(),
+			[](const auto &pair) { return pair.second.last; }));
+	}
+	_widths.emplace(width, WidthUse{ .first = now, .last = now });
+	return false;
+}
+
+[[nodiscard]] QSize CountTextSize(
+		const Ui::Text::String &text,
+		uint64 key,
+		int width) {
+	static auto Sizes = TextSizesCache();
+
+	if (!key
+		|| text.hasCollapsedBlockquots()
+		|| text.nextFormattedDateUpdate()) {
+		return text.countSize(width);
+	}
+	const auto cacheKey = TextSizeKey(key, width);
+	if (const auto cached = Sizes.find(cacheKey)) {
+		return *cached;
+	}
+	const auto result = text.countSize(width);
+	if (Sizes.stableWidth(width)) {
+		Sizes.store(cacheKey, result);
+	}
+	return result;
+}
+
 } // namespace
 
 std::unique_ptr<Ui::PathShiftGradient> MakePathShiftGradient(
@@ -1545,6 +1670,7 @@ void Element::overrideMedia(std::unique_ptr<Media> media) {
 	Expects(!history()->owner().groups().find(data()));
 
 	_text = Ui::Text::String(st::msgMinWidth);
+	_textContentKey = _textLayoutKey = 0;
 	invalidateTextSizeCache();
 
 	_media = std::move(media);
@@ -1806,7 +1932,10 @@ int Element::textHeightFor(int textWidth) const {
 					const_cast<Element*>(this));
 			}
 		} else {
-			const auto result = _text.countSize(textWidth);
+			const auto result = CountTextSize(
+				_text,
+				_textLayoutKey,
+				textWidth);
 			_textRealWidth = std::clamp(result.width(), 0, kMaxWidth);
 			_textHeight = result.height();
 		}
@@ -2181,6 +2310,7 @@ void Element::setTextWithLinks(
 	if (_flags & Flag::ServiceMessage) {
 		const auto &options = Ui::ItemTextServiceOptions();
 		_text.setMarkedText(st::serviceTextStyle, text, options, context);
+		_textContentKey = TextContentKey(text, st::serviceTextStyle, options);
 		auto linkIndex = 0;
 		for (const auto &link : links) {
 			// Link indices start with 1.
@@ -2191,6 +2321,7 @@ void Element::setTextWithLinks(
 		const auto &options = Ui::ItemTextOptions(item);
 		clearSpecialOnlyEmoji();
 		_text.setMarkedText(st::messageTextStyle, text, options, context);
+		_textContentKey = TextContentKey(text, st::messageTextStyle, options);
 		if (!item->_text.empty() && _text.isEmpty()){
 			// If server has allowed some text that we've trim-ed entirely,
 			// just replace it with something so that UI won't look buggy.
@@ -2204,6 +2335,7 @@ void Element::setTextWithLinks(
 			refreshMedia(nullptr);
 		}
 	}
+	_textLayoutKey = _textContentKey;
 	InitElementTextPart(this, _text);
 	if (const auto next = _text.nextFormattedDateUpdate()) {
 		history()->session().data().registerFormattedDateUpdate(next, this);
@@ -2214,11 +2346,17 @@ void Element::setTextWithLinks(
 void Element::validateTextSkipBlock(bool has, int width, int height) {
 	validateText();
 	if (!has) {
+		_textLayoutKey = _textContentKey;
 		if (_text.removeSkipBlock()) {
 			invalidateTextSizeCache();
 		}
-	} else if (_text.updateSkipBlock(width, height)) {
-		invalidateTextSizeCache();
+	} else {
+		_textLayoutKey = _textContentKey
+			? TextLayoutKey(_textContentKey, width, height)
+			: 0;
+		if (_text.updateSkipBlock(width, height)) {
+			invalidateTextSizeCache();
+		}
 	}
 }
 
@@ -2976,6 +3114,7 @@ void Element::itemTextUpdated() {
 	_flags &= ~Flag::SummaryShown;
 	clearSpecialOnlyEmoji();
 	_text = Ui::Text::String(st::msgMinWidth);
+	_textContentKey = _textLayoutKey = 0;
 	invalidateTextSizeCache();
 	if (_media && !data()->media()) {
 		refreshMedia(nullptr);
@@ -849,6 +849,8 @@ private:
 	mutable uint32 _textWidth : 16 = 0;
 	mutable uint32 _textRealWidth : 16 = 0;
 	mutable int _textHeight = 0;
+	uint64 _textContentKey = 0;
+	uint64 _textLayoutKey = 0;
 
 	int _y = 0;
 	int _indexInBlock = -1;
@@ -26,6 +26,8 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 #include "main/main_session.h"
 #include "spellcheck/platform/platform_language.h"
 
+#include <xxhash.h>
+
 namespace HistoryView {
 namespace {
 
@@ -34,6 +36,23 @@ constexpr auto kEnoughForTranslation = 6;
 constexpr auto kMaxCheckInBunch = 100;
 constexpr auto kRequestLengthLimit = 24 * 1024;
 constexpr auto kRequestCountLimit = 20;
+constexpr auto kRecognizedCacheLimit = 16384;
+constexpr auto kSlowRecognitionLatency = crl::time(200);
+
+[[nodiscard]] uint64 TextKey(const QString &text) {
+	return XXH64(text.constData(), text.size() * sizeof(QChar), 0);
+}
+
+// Languages of the recognized texts, shared by all trackers, so that
+// reopening a chat doesn't recognize the same messages once again.
+[[nodiscard]] std::unordered_map<uint64, LanguageId> &Recognized() {
+	static auto result = [] {
+		auto result = std::unordered_map<uint64, LanguageId>();
+		result.reserve(kRecognizedCacheLimit);
+		return result;
+	}();
+	return result;
+}
 
 } // namespace
 
@@ -150,7 +169,7 @@ bool TranslateTracker::add(
 	_itemsForRecognize.emplace(id, ItemForRecognize{
 		.generation = _generation,
 		.id = (_trackingLanguage.current()
-			? Platform::Language::Recognize(text)
+			? recognizeLater(id, text)
 			: MaybeLanguageId{ text }),
 	});
 	++_addedInBunch;
@@ -177,6 +196,7 @@ void TranslateTracker::finishBunch() {
 		_addedInBunch = -1;
 		applyLimit();
 		if (_trackingLanguage.current()) {
+			recognizeQueued();
 			checkRecognized();
 		}
 	}
@@ -459,9 +479,85 @@ void TranslateTracker::applyLimit() {
 void TranslateTracker::recognizeCollected() {
 	for (auto &[id, entry] : _itemsForRecognize) {
 		if (const auto text = std::get_if<QString>(&entry.id)) {
-			entry.id = Platform::Language::Recognize(*text);
+			entry.id = recognizeLater(id, *text);
 		}
 	}
+	recognizeQueued();
+}
+
+auto TranslateTracker::recognizeLater(
+		FullMsgId id,
+		const QString &text) -> MaybeLanguageId {
+	const auto key = TextKey(text);
+	const auto &cache = Recognized();
+	if (const auto i = cache.find(key); i != end(cache)) {
+		return i->second;
+	}
+	_itemsToRecognize.push_back({ .id = id, .key = key, .text = text });
+	return text;
+}
+
+void TranslateTracker::recognizeQueued() {
+	if (_itemsToRecognize.empty()) {
+		return;
+	}
+	++_recognizing;
+	const auto started = crl::now();
+	const auto weak = base::make_weak(this);
+	crl::async([=, items = base::take(_itemsToRecognize)]() mutable {
+		auto results = std::vector<LanguageId>();
+		results.reserve(items.size());
+		for (const auto &item : items) {
+			results.push_back(Platform::Language::Recognize(item.text));
+		}
+		crl::on_main(weak, [
+			=,
+			items = std::move(items),
+			results = std::move(results)
+		] {
+			recognized(items, results, crl::now() - started);
+		});
+	});
+}
+
+void TranslateTracker::recognized(
+		const std::vector<ItemToRecognize> &items,
+		const std::vector<LanguageId> &results,
+		crl::time latency) {
+	Expects(items.size() == results.size());
+
+	--_recognizing;
+	auto &cache = Recognized();
+	if (cache.size() + items.size() > kRecognizedCacheLimit) {
+		cache.clear();
+	}
+	for (auto i = 0, count = int(items.size()); i != count; ++i) {
+		const auto &item = items[i];
+		cache[item.key] = results[i];
+		const auto j = _itemsForRecognize.find(item.id);
+		if (j == end(_itemsForRecognize)) {
+			continue;
+		} else if (const auto text = std::get_if<QString>(&j->second.id)) {
+			if (TextKey(*text) == item.key) {
+				j->second.id = results[i];
+			}
+		}
+	}
+	_recognitionLatency = _recognitionLatency
+		? ((_recognitionLatency * 3 + latency) / 4)
+		: latency;
+	DEBUG_LOG(("Translate Tracker: %1 texts recognized in %2 ms."
+		).arg(items.size()
+		).arg(latency));
+
+	// While newer texts are still being recognized the offer is kept,
+	// so that it doesn't blink on every scroll bunch. Unless that takes
+	// long enough to notice the offer coming late.
+	if (_trackingLanguage.current()
+		&& (!_recognizing
+			|| _recognitionLatency >= kSlowRecognitionLatency)) {
+		checkRecognized();
+	}
 }
 
 void TranslateTracker::trackSkipLanguages() {
@@ -502,15 +598,16 @@ void TranslateTracker::checkRecognized(const std::vector<LanguageId> &skip) {
 		return;
 	}
 	auto languages = base::flat_map<LanguageId, int>();
+	auto count = 0;
 	for (const auto &[id, entry] : _itemsForRecognize) {
 		if (const auto id = std::get_if<LanguageId>(&entry.id)) {
 			if (*id && !ranges::contains(skip, *id)) {
 				++languages[*id];
 			}
+			++count;
 		}
 	}
 	using namespace base;
-	const auto count = int(_itemsForRecognize.size());
 	constexpr auto p = &flat_multi_map_pair_type<LanguageId, int>::second;
 	const auto threshold = (count > kEnoughForRecognition)
 		? (count * kEnoughForTranslation / kEnoughForRecognition)
@@ -7,6 +7,7 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 */
 #pragma once
 
+#include "base/weak_ptr.h"
 #include "mtproto/sender.h"
 #include "spellcheck/spellcheck_types.h"
 
@@ -20,7 +21,7 @@ namespace HistoryView {
 
 class Element;
 
-class TranslateTracker final {
+class TranslateTracker final : public base::has_weak_ptr {
 public:
 	explicit TranslateTracker(not_null<History*> history);
 	~TranslateTracker();
@@ -46,10 +47,23 @@ private:
 		int length = 0;
 		bool rich = false;
 	};
+	struct ItemToRecognize {
+		FullMsgId id;
+		uint64 key = 0;
+		QString text;
+	};
 
 	void setup();
 	bool add(not_null<HistoryItem*> item, bool skipDependencies);
 	void recognizeCollected();
+	[[nodiscard]] MaybeLanguageId recognizeLater(
+		FullMsgId id,
+		const QString &text);
+	void recognizeQueued();
+	void recognized(
+		const std::vector<ItemToRecognize> &items,
+		const std::vector<LanguageId> &results,
+		crl::time latency);
 	void trackSkipLanguages();
 	void trackTranslationDisabled();
 	void checkRecognized();
@@ -67,6 +81,9 @@ private:
 	MTP::Sender _api;
 	rpl::variable<bool> _trackingLanguage = false;
 	base::flat_map<FullMsgId, ItemForRecognize> _itemsForRecognize;
+	std::vector<ItemToRecognize> _itemsToRecognize;
+	int _recognizing = 0;
+	crl::time _recognitionLatency = 0;
 	uint64 _generation = 0;
 	LanguageId _bunchTranslatedTo;
 	int _limit = 0;
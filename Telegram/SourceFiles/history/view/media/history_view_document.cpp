@@ -10,7 +10,6 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 #include "base/random.h"
 #include "lang/lang_keys.h"
 #include "lottie/lottie_icon.h"
-#include "storage/localstorage.h"
 #include "main/main_session.h"
 #include "media/player/media_player_float.h" // Media::Player::RoundPainter.
 #include "media/audio/media_audio.h"
@@ -992,7 +991,7 @@ void Document::draw(
 				: _data->voice();
 			if (voiceData && voiceData->waveform.isEmpty()) {
 				if (loaded) {
-					Local::countVoiceWaveform(_dataMedia.get());
+					_dataMedia->voiceWaveformWanted();
 				}
 			}
 		}
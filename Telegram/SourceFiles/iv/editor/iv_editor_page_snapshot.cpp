@@ -0,0 +1,169 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "iv/editor/iv_editor_page_snapshot.h"
+
+namespace Iv::Editor {
+namespace {
+
+constexpr auto kChunkSize = 64;
+
+} // namespace
+
+PageSnapshot::PageSnapshot(const RichPage &page)
+: PageSnapshot(Share(page, PageSnapshot())) {
+}
+
+PageSnapshot PageSnapshot::Share(
+		const RichPage &page,
+		const PageSnapshot &base) {
+	const auto count = int(page.blocks.size());
+	const auto baseCount = base._blocksCount;
+	const auto limit = std::min(count, baseCount);
+	auto prefix = 0;
+	while (prefix < limit && base.block(prefix) == page.blocks[prefix]) {
+		++prefix;
+	}
+	auto suffix = 0;
+	while (suffix < limit - prefix
+		&& (base.block(baseCount - suffix - 1)
+			== page.blocks[count - suffix - 1])) {
+		++suffix;
+	}
+
+	auto blocks = std::vector<BlockPointer>();
+	blocks.reserve(count);
+	for (auto i = 0; i != prefix; ++i) {
+		blocks.push_back(base.blockPointer(i));
+	}
+	for (auto i = prefix; i != count - suffix; ++i) {
+		blocks.push_back(
+			std::make_shared<const RichPage::Block>(page.blocks[i]));
+	}
+	for (auto i = count - suffix; i != count; ++i) {
+		blocks.push_back(base.blockPointer(baseCount - (count - i)));
+	}
+
+	auto result = PageSnapshot();
+	result.assignHeader(page);
+	result.fill(std::move(blocks), base);
+	return result;
+}
+
+int PageSnapshot::blocksCount() const {
+	return _blocksCount;
+}
+
+const RichPage::Block &PageSnapshot::block(int index) const {
+	return *blockPointer(index);
+}
+
+RichPage PageSnapshot::materialize() const {
+	auto result = RichPage{
+		.url = _url,
+		.rtl = _rtl,
+		.part = _part,
+		.views = _views,
+	};
+	result.blocks.reserve(_blocksCount);
+	for (const auto &chunk : _chunks) {
+		for (const auto &block : *chunk) {
+			result.blocks.push_back(*block);
+		}
+	}
+	return result;
+}
+
+int PageSnapshot::sharedBlocksCount(const PageSnapshot &other) const {
+	const auto count = std::min(_blocksCount, other._blocksCount);
+	auto result = 0;
+	for (auto i = 0; i != count; ++i) {
+		if (blockPointer(i) == other.blockPointer(i)) {
+			++result;
+		}
+	}
+	return result;
+}
+
+void PageSnapshot::assignHeader(const RichPage &page) {
+	_url = page.url;
+	_rtl = page.rtl;
+	_part = page.part;
+	_views = page.views;
+}
+
+void PageSnapshot::replaceBlock(int index, const RichPage::Block &block) {
+	Expects(index >= 0 && index < _blocksCount);
+
+	auto &chunk = _chunks[index / kChunkSize];
+	const auto position = index % kChunkSize;
+	if (*(*chunk)[position] == block) {
+		return;
+	}
+	auto copy = *chunk;
+	copy[position] = std::make_shared<const RichPage::Block>(block);
+	chunk = std::make_shared<const Chunk>(std::move(copy));
+}
+
+auto PageSnapshot::blockPointer(int index) const -> const BlockPointer & {
+	Expects(index >= 0 && index < _blocksCount);
+
+	return (*_chunks[index / kChunkSize])[index % kChunkSize];
+}
+
+void PageSnapshot::fill(
+		std::vector<BlockPointer> blocks,
+		const PageSnapshot &base) {
+	_blocksCount = int(blocks.size());
+	_chunks.clear();
+	_chunks.reserve((_blocksCount + kChunkSize - 1) / kChunkSize);
+	for (auto from = 0; from < _blocksCount; from += kChunkSize) {
+		const auto till = std::min(from + kChunkSize, _blocksCount);
+		const auto index = from / kChunkSize;
+		if (index < int(base._chunks.size())) {
+			const auto &existing = base._chunks[index];
+			if (std::equal(
+					existing->begin(),
+					existing->end(),
+					blocks.begin() + from,
+					blocks.begin() + till)) {
+				_chunks.push_back(existing);
+				continue;
+			}
+		}
+		_chunks.push_back(std::make_shared<const Chunk>(
+			std::make_move_iterator(blocks.begin() + from),
+			std::make_move_iterator(blocks.begin() + till)));
+	}
+}
+
+bool operator==(const PageSnapshot &a, const PageSnapshot &b) {
+	if (a._blocksCount != b._blocksCount
+		|| a._url != b._url
+		|| a._rtl != b._rtl
+		|| a._part != b._part
+		|| a._views != b._views) {
+		return false;
+	}
+	for (auto i = 0, count = int(a._chunks.size()); i != count; ++i) {
+		const auto &first = a._chunks[i];
+		const auto &second = b._chunks[i];
+		if (first == second) {
+			continue;
+		}
+		for (auto j = 0, size = int(first->size()); j != size; ++j) {
+			const auto &left = (*first)[j];
+			const auto &right = (*second)[j];
+			if (left != right && *left != *right) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+} // namespace Iv::Editor
@@ -0,0 +1,62 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "iv/iv_rich_page.h"
+
+#include <memory>
+#include <vector>
+
+namespace Iv::Editor {
+
+// Immutable copy of a RichPage for the undo history.
+//
+// Top-level blocks are stored as shared immutable values grouped in
+// fixed size chunks, so a snapshot taken after a local edit copies only
+// the edited block and the chunk holding it, sharing the rest of the
+// page with the previous snapshot.
+class PageSnapshot final {
+public:
+	PageSnapshot() = default;
+	explicit PageSnapshot(const RichPage &page);
+
+	// Builds a snapshot of the page, reusing the blocks of the base
+	// snapshot that are equal to the ones in the page.
+	[[nodiscard]] static PageSnapshot Share(
+		const RichPage &page,
+		const PageSnapshot &base);
+
+	[[nodiscard]] int blocksCount() const;
+	[[nodiscard]] const RichPage::Block &block(int index) const;
+	[[nodiscard]] RichPage materialize() const;
+
+	// Counts top-level blocks stored in the same memory in both snapshots.
+	[[nodiscard]] int sharedBlocksCount(const PageSnapshot &other) const;
+
+	void assignHeader(const RichPage &page);
+	void replaceBlock(int index, const RichPage::Block &block);
+
+	friend bool operator==(const PageSnapshot &a, const PageSnapshot &b);
+
+private:
+	using BlockPointer = std::shared_ptr<const RichPage::Block>;
+	using Chunk = std::vector<BlockPointer>;
+
+	[[nodiscard]] const BlockPointer &blockPointer(int index) const;
+	void fill(std::vector<BlockPointer> blocks, const PageSnapshot &base);
+
+	QString _url;
+	bool _rtl = false;
+	bool _part = false;
+	int _views = 0;
+	std::vector<std::shared_ptr<const Chunk>> _chunks;
+	int _blocksCount = 0;
+
+};
+
+} // namespace Iv::Editor
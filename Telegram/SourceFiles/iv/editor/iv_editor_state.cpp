@@ -783,6 +783,7 @@ void State::commitCheckedMutation(State state) {
 		: PreparedMutationKind::FullRebuild;
 	_lastLimitError = std::nullopt;
 	_temporaryDownParagraph = std::move(state._temporaryDownParagraph);
+	markPageSnapshotStale();
 }
 
 const std::vector<TextNodeDescriptor> &State::textNodes() const {
@@ -790,15 +791,17 @@ const std::vector<TextNodeDescriptor> &State::textNodes() const {
 }
 
 State::Snapshot State::snapshot() const {
+	syncPageSnapshot();
 	return {
-		.richPage = *_richPage,
+		.richPage = _pageSnapshot,
 		.activeLeaf = activeLeafPath(),
 		.temporaryDownParagraph = _temporaryDownParagraph,
 	};
 }
 
 void State::restoreSnapshot(Snapshot snapshot) {
-	_richPage = std::make_shared<RichPage>(std::move(snapshot.richPage));
+	_richPage = std::make_shared<RichPage>(snapshot.richPage.materialize());
+	_pageSnapshot = std::move(snapshot.richPage);
 	_activeTextOrdinal = -1;
 	_lastLimitError = std::nullopt;
 	_temporaryDownParagraph = std::move(snapshot.temporaryDownParagraph);
@@ -965,6 +968,7 @@ ApplyResult State::applyActiveTextUnchecked(TextWithEntities text) {
 			}
 			if (updatePreparedActiveLeaf(*descriptor)) {
 				_lastPreparedMutationKind = PreparedMutationKind::LeafOnly;
+				markPageSnapshotBlockDirty(descriptor->leaf);
 			} else {
 				rebuildPrepared();
 			}
@@ -981,6 +985,7 @@ ApplyResult State::applyActiveTextUnchecked(TextWithEntities text) {
 		if (leafMutationKeepsTextNodes(*descriptor)) {
 			if (updatePreparedActiveLeaf(*descriptor)) {
 				_lastPreparedMutationKind = PreparedMutationKind::LeafOnly;
+				markPageSnapshotBlockDirty(descriptor->leaf);
 			} else {
 				rebuildPrepared();
 			}
@@ -1102,6 +1107,7 @@ ApplyResult State::applyActiveRawTextUnchecked(QString text) {
 		if (leafMutationKeepsTextNodes(*descriptor)) {
 			if (updatePreparedActiveLeaf(*descriptor)) {
 				_lastPreparedMutationKind = PreparedMutationKind::LeafOnly;
+				markPageSnapshotBlockDirty(descriptor->leaf);
 			} else {
 				rebuildPrepared();
 			}
@@ -1124,6 +1130,7 @@ ApplyResult State::applyActiveRawTextUnchecked(QString text) {
 			}
 			if (updatePreparedActiveLeaf(*descriptor)) {
 				_lastPreparedMutationKind = PreparedMutationKind::LeafOnly;
+				markPageSnapshotBlockDirty(descriptor->leaf);
 			} else {
 				rebuildPrepared();
 			}
@@ -9978,6 +9985,7 @@ void State::rebuild() {
 
 void State::rebuildPrepared() {
 	_lastPreparedMutationKind = PreparedMutationKind::FullRebuild;
+	markPageSnapshotStale();
 	_richPage->rtl = DetermineRichPageRtl(*_richPage);
 	_prepared = Markdown::TryPrepareNativeInstantView({
 		.richPage = _richPage,
@@ -9987,6 +9995,36 @@ void State::rebuildPrepared() {
 	}).content;
 }
 
+void State::markPageSnapshotStale() {
+	_pageSnapshotStale = true;
+	_pageSnapshotDirtyBlocks.clear();
+}
+
+void State::markPageSnapshotBlockDirty(const LeafPath &leaf) {
+	if (_pageSnapshotStale) {
+		return;
+	}
+	const auto &container = leaf.block.container;
+	const auto index = container.steps.empty()
+		? leaf.block.index
+		: container.steps.front().blockIndex;
+	if (!ranges::contains(_pageSnapshotDirtyBlocks, index)) {
+		_pageSnapshotDirtyBlocks.push_back(index);
+	}
+}
+
+void State::syncPageSnapshot() const {
+	if (_pageSnapshotStale) {
+		_pageSnapshot = PageSnapshot::Share(*_richPage, _pageSnapshot);
+		_pageSnapshotStale = false;
+	} else {
+		// Leaf-only edits keep the blocks count and page header.
+		for (const auto index : base::take(_pageSnapshotDirtyBlocks)) {
+			_pageSnapshot.replaceBlock(index, _richPage->blocks[index]);
+		}
+	}
+}
+
 void State::rebuildTextNodes() {
 	_textNodes.clear();
 	_textNodes.reserve(_richPage->blocks.size() * 3);
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "iv/editor/iv_editor_page_blocks.h"
 #include "iv/editor/iv_editor_page_list.h"
 #include "iv/editor/iv_editor_page_path.h"
+#include "iv/editor/iv_editor_page_snapshot.h"
 #include "iv/iv_rich_page.h"
 #include "iv/markdown/iv_markdown_prepare.h"
 
@@ -51,7 +52,7 @@ public:
 	using LeafPath = Editor::LeafPath;
 
 	struct Snapshot {
-		RichPage richPage;
+		PageSnapshot richPage;
 		std::optional<LeafPath> activeLeaf;
 		std::optional<LeafPath> temporaryDownParagraph;
 	};
@@ -675,6 +676,9 @@ private:
 
 	void rebuild();
 	void rebuildPrepared();
+	void markPageSnapshotStale();
+	void markPageSnapshotBlockDirty(const LeafPath &leaf);
+	void syncPageSnapshot() const;
 	void rebuildTextNodes();
 	void rebuildTextNodes(
 		const std::vector<RichPage::Block> &blocks,
@@ -994,6 +998,11 @@ private:
 	std::optional<RichMessageLimitError> _lastLimitError;
 	std::optional<LeafPath> _temporaryDownParagraph;
 
+	// History snapshots share unchanged top-level blocks with this one.
+	mutable PageSnapshot _pageSnapshot;
+	mutable std::vector<int> _pageSnapshotDirtyBlocks;
+	mutable bool _pageSnapshotStale = true;
+
 };
 
 enum class RequestMediaType : uchar {
@@ -9,6 +9,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include "base/invoke_queued.h"
 #include "iv/iv_search_bar.h"
+#include "iv/iv_search_index.h"
 #include "iv/markdown/iv_markdown_article.h"
 #include "logs.h"
 
@@ -136,6 +137,43 @@ auto SearchController::ScanSearchEntries(
 	return result;
 }
 
+auto SearchController::BuildSearchIndex(const SearchSources &sources)
+-> std::shared_ptr<const SearchIndex> {
+	// Each source is indexed as its text followed by its hidden text.
+	auto documents = std::vector<QString>();
+	documents.reserve(sources.size() * 2);
+	for (const auto &source : sources) {
+		documents.push_back(source.text);
+		documents.push_back(source.hiddenText);
+	}
+	return std::make_shared<const SearchIndex>(documents);
+}
+
+auto SearchController::IndexSearchEntries(
+		const SearchSources &sources,
+		const SearchIndex &index,
+		const QString &query)
+-> std::vector<SearchEntry> {
+	Expects(index.documentsCount() == int(sources.size()) * 2);
+
+	auto result = std::vector<SearchEntry>();
+	for (const auto &match : index.find(query)) {
+		const auto segment = match.document / 2;
+		if (match.document % 2) {
+			result.push_back({
+				.hiddenDetailsId = sources[segment].detailsAnchorId,
+			});
+		} else {
+			result.push_back({
+				.segment = segment,
+				.from = match.from,
+				.to = match.to,
+			});
+		}
+	}
+	return result;
+}
+
 void SearchController::ensureSearchSnapshot() {
 	if (_searchSnapshot || !_host.ready()) {
 		return;
@@ -146,6 +184,7 @@ void SearchController::ensureSearchSnapshot() {
 
 void SearchController::invalidateSearchSession() {
 	_searchSnapshot = nullptr;
+	_searchIndex = nullptr;
 	_searchCache.clear();
 	++_searchGeneration;
 }
@@ -183,6 +222,14 @@ void SearchController::rebuildSearchResults(
 		auto entries = i->second;
 		applySearchEntries(std::move(entries), preferredCurrent, activate);
 		return;
+	} else if (_searchIndex) {
+		auto entries = IndexSearchEntries(
+			*_searchSnapshot,
+			*_searchIndex,
+			_searchQuery);
+		_searchCache.emplace(_searchQuery, entries);
+		applySearchEntries(std::move(entries), preferredCurrent, activate);
+		return;
 	}
 	if (_searchScanInFlight) {
 		DEBUG_LOG(("Native Markdown IV: search coalesced: %1"
@@ -224,17 +271,20 @@ void SearchController::startSearchScan() {
 		if (!weak) {
 			return;
 		}
-		auto entries = ScanSearchEntries(*snapshot, query);
+		auto index = BuildSearchIndex(*snapshot);
+		auto entries = IndexSearchEntries(*snapshot, *index, query);
 		crl::on_main([
 			weak,
 			query,
 			generation,
+			index = std::move(index),
 			entries = std::move(entries)
 		]() mutable {
 			if (const auto strong = weak.get()) {
 				strong->finishSearchScan(
 					query,
 					generation,
+					std::move(index),
 					std::move(entries));
 			}
 		});
@@ -244,6 +294,7 @@ void SearchController::startSearchScan() {
 void SearchController::finishSearchScan(
 		const QString &query,
 		int generation,
+		std::shared_ptr<const SearchIndex> index,
 		std::vector<SearchEntry> &&entries) {
 	_searchScanInFlight = false;
 	if (generation != _searchGeneration) {
@@ -253,6 +304,7 @@ void SearchController::finishSearchScan(
 		DEBUG_LOG(("Native Markdown IV: search response: %1 (%2 matches)"
 			).arg(query
 			).arg(int(entries.size())));
+		_searchIndex = std::move(index);
 		_searchCache[query] = entries;
 	}
 	if (!_searchBar->shown() || _searchQuery.isEmpty()) {
@@ -27,6 +27,8 @@ struct MarkdownArticleSearchSource;
 
 namespace Iv {
 
+class SearchIndex;
+
 struct SearchHost {
 	Fn<bool()> ready;
 	Fn<std::vector<Markdown::MarkdownArticleSearchSource>()> sources;
@@ -74,6 +76,12 @@ private:
 	[[nodiscard]] static std::vector<SearchEntry> ScanSearchEntries(
 		const SearchSources &sources,
 		const QString &query);
+	[[nodiscard]] static std::shared_ptr<const SearchIndex> BuildSearchIndex(
+		const SearchSources &sources);
+	[[nodiscard]] static std::vector<SearchEntry> IndexSearchEntries(
+		const SearchSources &sources,
+		const SearchIndex &index,
+		const QString &query);
 	void ensureSearchSnapshot();
 	void invalidateSearchSession();
 	[[nodiscard]] std::vector<SearchEntry> rescanSearchEntries();
@@ -85,6 +93,7 @@ private:
 	void finishSearchScan(
 		const QString &query,
 		int generation,
+		std::shared_ptr<const SearchIndex> index,
 		std::vector<SearchEntry> &&entries);
 
 	const not_null<QWidget*> _barParent;
@@ -94,6 +103,7 @@ private:
 	std::vector<SearchEntry> _searchEntries;
 	int _searchCurrentEntry = -1;
 	std::shared_ptr<const SearchSources> _searchSnapshot;
+	std::shared_ptr<const SearchIndex> _searchIndex;
 	base::flat_map<QString, std::vector<SearchEntry>> _searchCache;
 	int _searchGeneration = 0;
 	int _searchDesiredCurrent = 0;
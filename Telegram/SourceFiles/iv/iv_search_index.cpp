@@ -0,0 +1,134 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "iv/iv_search_index.h"
+
+namespace Iv {
+namespace {
+
+constexpr auto kGram = 3;
+
+// Simple per code point folding, keeping offsets of the source text.
+[[nodiscard]] QString Fold(const QString &text) {
+	auto result = text;
+	auto data = result.data();
+	for (auto i = 0, size = int(result.size()); i != size; ++i) {
+		const auto ch = data[i];
+		if (ch.isHighSurrogate()
+			&& (i + 1 < size)
+			&& data[i + 1].isLowSurrogate()) {
+			const auto folded = QChar::toCaseFolded(
+				QChar::surrogateToUcs4(ch, data[i + 1]));
+			if (QChar::requiresSurrogates(folded)) {
+				data[i] = QChar(QChar::highSurrogate(folded));
+				data[i + 1] = QChar(QChar::lowSurrogate(folded));
+			}
+			++i;
+		} else {
+			data[i] = ch.toCaseFolded();
+		}
+	}
+	return result;
+}
+
+[[nodiscard]] uint64 TrigramKey(const QChar *data) {
+	return (uint64(data[0].unicode()) << 32)
+		| (uint64(data[1].unicode()) << 16)
+		| uint64(data[2].unicode());
+}
+
+} // namespace
+
+SearchIndex::SearchIndex(const std::vector<QString> &documents) {
+	_folded.reserve(documents.size());
+	for (auto i = 0, count = int(documents.size()); i != count; ++i) {
+		_folded.push_back(Fold(documents[i]));
+		const auto &text = _folded.back();
+		const auto data = text.constData();
+		for (auto j = 0, till = int(text.size()) - kGram + 1; j < till; ++j) {
+			_trigrams[TrigramKey(data + j)].push_back({
+				.document = i,
+				.offset = j,
+			});
+		}
+	}
+}
+
+int SearchIndex::documentsCount() const {
+	return int(_folded.size());
+}
+
+std::vector<SearchIndexMatch> SearchIndex::find(const QString &query) const {
+	const auto folded = Fold(query);
+	const auto length = int(folded.size());
+	if (!length) {
+		return {};
+	} else if (length < kGram) {
+		return scan(folded);
+	}
+
+	// Candidates come from the rarest trigram of the query, they are
+	// already sorted by document and offset.
+	const std::vector<Posting> *rarest = nullptr;
+	auto shift = 0;
+	for (auto i = 0; i + kGram <= length; ++i) {
+		const auto j = _trigrams.find(TrigramKey(folded.constData() + i));
+		if (j == end(_trigrams)) {
+			return {};
+		} else if (!rarest || j->second.size() < rarest->size()) {
+			rarest = &j->second;
+			shift = i;
+		}
+	}
+	auto result = std::vector<SearchIndexMatch>();
+	auto document = -1;
+	auto till = 0;
+	for (const auto &posting : *rarest) {
+		const auto from = posting.offset - shift;
+		if (from < 0) {
+			continue;
+		} else if (posting.document != document) {
+			document = posting.document;
+			till = 0;
+		} else if (from < till) {
+			continue;
+		}
+		const auto &text = _folded[document];
+		if (from + length > int(text.size())
+			|| QStringView(text).mid(from, length) != QStringView(folded)) {
+			continue;
+		}
+		result.push_back({
+			.document = document,
+			.from = from,
+			.to = from + length,
+		});
+		till = from + length;
+	}
+	return result;
+}
+
+std::vector<SearchIndexMatch> SearchIndex::scan(
+		const QString &folded) const {
+	auto result = std::vector<SearchIndexMatch>();
+	const auto length = int(folded.size());
+	for (auto i = 0, count = int(_folded.size()); i != count; ++i) {
+		const auto &text = _folded[i];
+		auto from = 0;
+		while ((from = int(text.indexOf(folded, from))) >= 0) {
+			result.push_back({
+				.document = i,
+				.from = from,
+				.to = from + length,
+			});
+			from += length;
+		}
+	}
+	return result;
+}
+
+} // namespace Iv
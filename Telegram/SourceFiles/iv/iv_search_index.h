@@ -0,0 +1,50 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "base/basic_types.h"
+
+#include <unordered_map>
+#include <vector>
+#include <QtCore/QString>
+
+namespace Iv {
+
+struct SearchIndexMatch {
+	int document = -1;
+	int from = 0;
+	int to = 0;
+};
+
+// Case folded trigram index over a fixed set of texts.
+//
+// Matches are the ones QString::indexOf with Qt::CaseInsensitive finds
+// scanning each text from the start without overlapping.
+class SearchIndex final {
+public:
+	explicit SearchIndex(const std::vector<QString> &documents);
+
+	[[nodiscard]] int documentsCount() const;
+	[[nodiscard]] std::vector<SearchIndexMatch> find(
+		const QString &query) const;
+
+private:
+	struct Posting {
+		int document = 0;
+		int offset = 0;
+	};
+
+	[[nodiscard]] std::vector<SearchIndexMatch> scan(
+		const QString &folded) const;
+
+	std::vector<QString> _folded;
+	std::unordered_map<uint64, std::vector<Posting>> _trigrams;
+
+};
+
+} // namespace Iv
@@ -39,6 +39,9 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace Iv::Markdown {
 namespace {
 
+// Articles with fewer top-level blocks are always laid out completely.
+constexpr auto kEstimatedLayoutMinBlocks = 256;
+
 struct PendingHighlightKey {
 	QString text;
 	QString language;
@@ -3848,6 +3851,11 @@ public:
 
 	void setVisibleTopBottom(int visibleTop, int visibleBottom);
 
+	[[nodiscard]] bool hasEstimatedLayout() const;
+
+	[[nodiscard]] auto refineEstimatedLayout()
+	-> std::optional<MarkdownArticleLayoutRefinement>;
+
 	void paint(Painter &p, const MarkdownArticlePaintContext &context);
 
 	[[nodiscard]] MarkdownArticleHitTestResult hitTest(
@@ -4166,6 +4174,9 @@ private:
 	void publishInlineButtonWidthCap();
 	void relayout(int width);
 	void relayoutRetained(int width);
+	[[nodiscard]] LayoutContext retainedLayoutContext(int innerWidth);
+	[[nodiscard]] auto estimatedLayoutWindow() const
+	-> std::optional<LaidOutBlocksWindow>;
 	void retainBlocks();
 	[[nodiscard]] const LaidOutBlock *pullquoteBlockForEditableLeaf(
 		const PreparedEditLeafSource &source) const;
@@ -4193,6 +4204,7 @@ private:
 	CachedTextLeafPool _cachedTextLeafs;
 	std::vector<LaidOutBlock> _blocks;
 	std::vector<LaidOutBlock> _retainedBlocks;
+	int _estimatedBlocks = 0;
 	MediaBlockStorage _mediaBlocks;
 	int _missingMediaBlocks = 0;
 	std::unordered_map<uint64, std::shared_ptr<PlaceholderBlockRuntime>>
@@ -4628,6 +4640,70 @@ void MarkdownArticle::Impl::setVisibleTopBottom(int visibleTop, int visibleBotto
 	refreshVisibleSegmentSpan();
 }
 
+bool MarkdownArticle::Impl::hasEstimatedLayout() const {
+	return (_estimatedBlocks > 0);
+}
+
+auto MarkdownArticle::Impl::refineEstimatedLayout()
+-> std::optional<MarkdownArticleLayoutRefinement> {
+	const auto window = (_estimatedBlocks > 0 && _width > 0)
+		? estimatedLayoutWindow()
+		: std::nullopt;
+	const auto intersects = [&](const LaidOutBlock &block) {
+		return (block.outer.y() < window->bottom)
+			&& (block.outer.y() + block.outer.height() >= window->top);
+	};
+	if (!window
+		|| ranges::none_of(_blocks, [&](const LaidOutBlock &block) {
+			return block.estimated && intersects(block);
+		})) {
+		return std::nullopt;
+	}
+
+	// Keep the first visible block in place, only the blocks above it
+	// change their height when laid out precisely.
+	const auto visibleTop = _visibleRange->top;
+	const auto anchor = ranges::find_if(_blocks, [&](
+			const LaidOutBlock &block) {
+		return (block.outer.y() + block.outer.height() > visibleTop);
+	});
+	const auto anchorIndex = int(anchor - begin(_blocks));
+	const auto anchorTop = (anchor != end(_blocks)) ? anchor->outer.y() : 0;
+
+	captureScrollState();
+	const auto &st = layoutStyle();
+	const auto &page = st.pagePadding;
+	const auto innerWidth = std::max(
+		_width - page.left() - page.right(),
+		1);
+	const auto context = retainedLayoutContext(innerWidth);
+	const auto contextScope = LayoutContextScope(context);
+	const auto y = RecountLaidOutBlocksInWindow(
+		_content.blocks.blocks,
+		_content.formulas,
+		&_blocks,
+		*window,
+		false,
+		st,
+		page.left(),
+		page.top(),
+		innerWidth,
+		context);
+	if (!y) {
+		relayout(base::take(_width));
+		return MarkdownArticleLayoutRefinement{
+			.height = std::max(_height, 1),
+		};
+	}
+	finalizeRelayout(*y);
+	return MarkdownArticleLayoutRefinement{
+		.height = std::max(_height, 1),
+		.visibleShift = (anchorIndex < int(_blocks.size()))
+			? (_blocks[anchorIndex].outer.y() - anchorTop)
+			: 0,
+	};
+}
+
 void MarkdownArticle::Impl::paint(
 		Painter &p,
 		const MarkdownArticlePaintContext &context) {
@@ -6596,6 +6672,7 @@ void MarkdownArticle::Impl::finalizeRelayout(int heightBottom) {
 		_blocks,
 		&_relatedArticleImages);
 	_height = heightBottom + page.bottom();
+	_estimatedBlocks = CountEstimatedBlocks(_blocks);
 	clearPendingHighlightBlockPointers();
 	_anchors.clear();
 	_segments.clear();
@@ -6747,6 +6824,40 @@ void MarkdownArticle::Impl::relayoutRetained(int width) {
 	const auto &st = layoutStyle();
 	const auto &page = st.pagePadding;
 	const auto innerWidth = std::max(width - page.left() - page.right(), 1);
+	const auto context = retainedLayoutContext(innerWidth);
+	const auto contextScope = LayoutContextScope(context);
+	const auto window = estimatedLayoutWindow();
+	const auto y = window
+		? RecountLaidOutBlocksInWindow(
+			_content.blocks.blocks,
+			_content.formulas,
+			&_blocks,
+			*window,
+			true,
+			st,
+			page.left(),
+			page.top(),
+			innerWidth,
+			context)
+		: RecountLaidOutBlocks(
+			_content.blocks.blocks,
+			_content.formulas,
+			&_blocks,
+			st,
+			page.left(),
+			page.top(),
+			innerWidth,
+			context);
+	if (!y) {
+		relayout(width);
+		return;
+	}
+	_width = width;
+	finalizeRelayout(*y);
+}
+
+LayoutContext MarkdownArticle::Impl::retainedLayoutContext(int innerWidth) {
+	const auto &page = layoutStyle().pagePadding;
 	auto context = LayoutContext{
 		.articleLeft = page.left(),
 		.articleWidth = innerWidth,
@@ -6799,22 +6910,21 @@ void MarkdownArticle::Impl::relayoutRetained(int width) {
 		= [=](const PreparedEditListItemSource &source) {
 			return getOrCreateTaskMarkerRippleRuntime(source);
 		};
-	const auto contextScope = LayoutContextScope(context);
-	const auto y = RecountLaidOutBlocks(
-		_content.blocks.blocks,
-		_content.formulas,
-		&_blocks,
-		st,
-		page.left(),
-		page.top(),
-		innerWidth,
-		context);
-	if (!y) {
-		relayout(width);
-		return;
+	return context;
+}
+
+auto MarkdownArticle::Impl::estimatedLayoutWindow() const
+-> std::optional<LaidOutBlocksWindow> {
+	if (!_visibleRange
+		|| _content.editMode
+		|| (int(_blocks.size()) < kEstimatedLayoutMinBlocks)) {
+		return std::nullopt;
 	}
-	_width = width;
-	finalizeRelayout(*y);
+	const auto height = _visibleRange->bottom - _visibleRange->top;
+	return LaidOutBlocksWindow{
+		.top = _visibleRange->top - height,
+		.bottom = _visibleRange->bottom + height,
+	};
 }
 
 MarkdownArticle::MarkdownArticle(
@@ -6945,6 +7055,15 @@ void MarkdownArticle::setVisibleTopBottom(int visibleTop, int visibleBottom) {
 	_impl->setVisibleTopBottom(visibleTop, visibleBottom);
 }
 
+bool MarkdownArticle::hasEstimatedLayout() const {
+	return _impl->hasEstimatedLayout();
+}
+
+auto MarkdownArticle::refineEstimatedLayout()
+-> std::optional<MarkdownArticleLayoutRefinement> {
+	return _impl->refineEstimatedLayout();
+}
+
 void MarkdownArticle::paint(
 		Painter &p,
 		const MarkdownArticlePaintContext &context) const {
@@ -364,6 +364,11 @@ struct MarkdownArticleScrollAnchor {
 	double fraction = 0.;
 };
 
+struct MarkdownArticleLayoutRefinement {
+	int height = 0;
+	int visibleShift = 0;
+};
+
 struct MarkdownArticleMediaGeometry {
 	PreparedEditBlockSource block;
 	QRect mediaRect;
@@ -420,6 +425,9 @@ public:
 	[[nodiscard]] auto countRevealLinesGeometry(int width)
 	-> std::vector<MarkdownArticleRevealLine>;
 	void setVisibleTopBottom(int visibleTop, int visibleBottom);
+	[[nodiscard]] bool hasEstimatedLayout() const;
+	[[nodiscard]] auto refineEstimatedLayout()
+	-> std::optional<MarkdownArticleLayoutRefinement>;
 	void paint(Painter &p, const MarkdownArticlePaintContext &context) const;
 	[[nodiscard]] MarkdownArticleHitTestResult hitTest(
 		QPoint point,
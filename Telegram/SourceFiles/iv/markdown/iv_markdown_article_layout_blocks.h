@@ -179,6 +179,7 @@ struct LaidOutBlock {
 	bool footer = false;
 	bool carriesInlineButton = false;
 	bool insideHorizontalScroll = false;
+	bool estimated = false;
 	int tableBorder = 0;
 	int horizontalScrollLeft = 0;
 	int horizontalScrollMax = 0;
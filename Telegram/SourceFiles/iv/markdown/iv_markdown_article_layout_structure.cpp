@@ -1368,6 +1368,49 @@ void FinalizeOwnerSelection(
 	int width,
 	LayoutContext context);
 
+[[nodiscard]] std::optional<WidthAnalysisNode> AnalyzeRetainedBlockAt(
+		const std::vector<PreparedBlock> &prepared,
+		const std::vector<LaidOutBlock> &blocks,
+		int index,
+		const std::vector<PreparedFormulaSlot> &formulas,
+		const style::Markdown &st,
+		int width,
+		LayoutContext context) {
+	const auto &preparedBlock = prepared[index];
+	const auto &block = blocks[index];
+	if (preparedBlock.kind != block.kind) {
+		return std::nullopt;
+	}
+	const auto next = NextVisibleBlock(prepared, index);
+	auto blockContext = context;
+	blockContext.preparedPath.push_back(index);
+	auto blockWidth = BlockBandWidth(preparedBlock.kind, st, width, context);
+	if (IsRelatedArticlesHeader(preparedBlock, next)) {
+		blockWidth = std::max(
+			width
+				- st.relatedArticle.headerPadding.left()
+				- st.relatedArticle.headerPadding.right(),
+			1);
+	}
+	const auto inlineButtonWidthCap = BlockInlineButtonWidthCap(
+		preparedBlock,
+		st,
+		blockWidth,
+		width,
+		context);
+	if (block.carriesInlineButton
+		&& (block.inlineButtonWidthCap != inlineButtonWidthCap)) {
+		return std::nullopt;
+	}
+	return AnalyzeRetainedBlock(
+		preparedBlock,
+		block,
+		formulas,
+		st,
+		blockWidth,
+		blockContext);
+}
+
 [[nodiscard]] std::optional<std::vector<WidthAnalysisNode>> AnalyzeRetainedBlocks(
 		const std::vector<PreparedBlock> &prepared,
 		const std::vector<LaidOutBlock> &blocks,
@@ -1381,39 +1424,14 @@ void FinalizeOwnerSelection(
 	auto result = std::vector<WidthAnalysisNode>();
 	result.reserve(prepared.size());
 	for (auto i = 0, count = int(prepared.size()); i != count; ++i) {
-		const auto &preparedBlock = prepared[i];
-		const auto &block = blocks[i];
-		if (preparedBlock.kind != block.kind) {
-			return std::nullopt;
-		}
-		const auto next = NextVisibleBlock(prepared, i);
-		auto blockContext = context;
-		blockContext.preparedPath.push_back(i);
-		auto blockWidth = BlockBandWidth(preparedBlock.kind, st, width, context);
-		if (IsRelatedArticlesHeader(preparedBlock, next)) {
-			blockWidth = std::max(
-				width
-					- st.relatedArticle.headerPadding.left()
-					- st.relatedArticle.headerPadding.right(),
-				1);
-		}
-		const auto inlineButtonWidthCap = BlockInlineButtonWidthCap(
-			preparedBlock,
+		auto analysis = AnalyzeRetainedBlockAt(
+			prepared,
+			blocks,
+			i,
+			formulas,
 			st,
-			blockWidth,
 			width,
 			context);
-		if (block.carriesInlineButton
-			&& (block.inlineButtonWidthCap != inlineButtonWidthCap)) {
-			return std::nullopt;
-		}
-		auto analysis = AnalyzeRetainedBlock(
-			preparedBlock,
-			block,
-			formulas,
-			st,
-			blockWidth,
-			blockContext);
 		if (!analysis) {
 			return std::nullopt;
 		}
@@ -4080,6 +4098,86 @@ int LayoutBlocks(
 	return outerRight;
 }
 
+[[nodiscard]] std::optional<int> RecountBlockAt(
+		const std::vector<PreparedBlock> &prepared,
+		const std::vector<PreparedFormulaSlot> &formulas,
+		LaidOutBlock *live,
+		int index,
+		const WidthAnalysisNode &analysis,
+		const WidthAnalysisNode *activeScrollOwner,
+		const style::Markdown &st,
+		int left,
+		int top,
+		int width,
+		int logicalWidth,
+		LayoutContext context) {
+	const auto &preparedBlock = prepared[index];
+	const auto relatedHeader = IsRelatedArticlesHeader(
+		preparedBlock,
+		NextVisibleBlock(prepared, index));
+	auto blockContext = context;
+	blockContext.preparedPath.push_back(index);
+	const auto band = BlockBand(
+		preparedBlock.kind,
+		st,
+		left,
+		std::max(width, 1),
+		context);
+	const auto logicalBandWidth = BlockBandWidth(
+		preparedBlock.kind,
+		st,
+		logicalWidth,
+		context);
+	const auto bottom = relatedHeader
+		? RecountSimpleLaidOutBlock(
+			preparedBlock,
+			formulas,
+			live,
+			st,
+			left + st.relatedArticle.headerPadding.left(),
+			top + st.relatedArticle.headerPadding.top(),
+			std::max(
+				width
+					- st.relatedArticle.headerPadding.left()
+					- st.relatedArticle.headerPadding.right(),
+				1),
+			std::max(
+				logicalWidth
+					- st.relatedArticle.headerPadding.left()
+					- st.relatedArticle.headerPadding.right(),
+				1),
+			false,
+			blockContext)
+		: RecountBlockInPlace(
+			preparedBlock,
+			formulas,
+			live,
+			analysis,
+			activeScrollOwner,
+			st,
+			band.x(),
+			top,
+			band.width(),
+			logicalBandWidth,
+			blockContext);
+	if (!bottom) {
+		return std::nullopt;
+	}
+	if (relatedHeader) {
+		live->headerRect = QRect(
+			left,
+			top,
+			std::max(width, 1),
+			live->outer.height()
+				+ st.relatedArticle.headerPadding.top()
+				+ st.relatedArticle.headerPadding.bottom());
+		live->outer = live->headerRect;
+		live->contentRect = live->headerRect;
+		RefreshLogicalGeometry(live);
+	}
+	return BlockBottom(*live);
+}
+
 [[nodiscard]] std::optional<int> RecountBlocksInPlace(
 		const std::vector<PreparedBlock> &prepared,
 		const std::vector<PreparedFormulaSlot> &formulas,
@@ -4103,7 +4201,6 @@ int LayoutBlocks(
 		const auto &preparedBlock = prepared[i];
 		auto &live = (*blocks)[i];
 		const auto anchorOnly = IsAnchorOnlyBlock(preparedBlock);
-		const auto next = NextVisibleBlock(prepared, i);
 		auto blockContext = context;
 		blockContext.preparedPath.push_back(i);
 		if (HideEmptyQuoteAuthorBlock(preparedBlock, blockContext)) {
@@ -4113,65 +4210,186 @@ int LayoutBlocks(
 		if (previous && !anchorOnly) {
 			y += BlockSkip(*previous, preparedBlock, context, st);
 		}
-		const auto band = BlockBand(
-			preparedBlock.kind,
+		const auto bottom = RecountBlockAt(
+			prepared,
+			formulas,
+			&live,
+			i,
+			analysis[i],
+			activeScrollOwner,
 			st,
 			left,
-			std::max(width, 1),
-			context);
-		const auto logicalBandWidth = BlockBandWidth(
-			preparedBlock.kind,
-			st,
+			y,
+			width,
 			logicalWidth,
 			context);
-		const auto bottom = IsRelatedArticlesHeader(preparedBlock, next)
-			? RecountSimpleLaidOutBlock(
-				preparedBlock,
+		if (!bottom) {
+			return std::nullopt;
+		}
+		live.estimated = false;
+		y = *bottom;
+		if (!anchorOnly) {
+			previous = &preparedBlock;
+		}
+	}
+	return y;
+}
+
+void ShiftLaidOutBlock(LaidOutBlock *block, int shift) {
+	const auto move = [&](QRect &rect) {
+		if (!rect.isNull()) {
+			rect.translate(0, shift);
+		}
+	};
+	auto &logical = block->logicalGeometry;
+	for (const auto rect : {
+		&block->outer,
+		&block->headerRect,
+		&block->bodyRect,
+		&block->iconRect,
+		&block->textRect,
+		&block->labelRect,
+		&block->subtitleRect,
+		&block->actionRect,
+		&block->markerRect,
+		&block->contentRect,
+		&block->collapseControlRect,
+		&block->buttonRowControlRect,
+		&block->formulaRect,
+		&block->tableRect,
+		&block->mediaRect,
+		&block->thumbnailRect,
+		&block->visibleFormulaRect,
+		&block->scrollViewportRect,
+		&block->scrollLogicalContentRect,
+		&block->scrollScrollbarTrackRect,
+		&block->scrollScrollbarThumbRect,
+		&block->visibleTableRect,
+		&block->tableScrollbarTrackRect,
+		&block->tableScrollbarThumbRect,
+		&block->visibleMediaRect,
+		&logical.outer,
+		&logical.headerRect,
+		&logical.bodyRect,
+		&logical.iconRect,
+		&logical.textRect,
+		&logical.labelRect,
+		&logical.subtitleRect,
+		&logical.actionRect,
+		&logical.markerRect,
+		&logical.contentRect,
+		&logical.collapseControlRect,
+		&logical.buttonRowControlRect,
+		&logical.formulaRect,
+		&logical.tableRect,
+		&logical.mediaRect,
+		&logical.thumbnailRect,
+	}) {
+		move(*rect);
+	}
+	if (!block->markerCenter.isNull()) {
+		block->markerCenter.ry() += shift;
+	}
+	if (!logical.markerCenter.isNull()) {
+		logical.markerCenter.ry() += shift;
+	}
+	if (block->firstLineBaseline >= 0) {
+		block->firstLineBaseline += shift;
+	}
+	for (auto &row : block->tableRows) {
+		move(row.outer);
+		move(row.logicalOuter);
+		for (auto &cell : row.cells) {
+			move(cell.outer);
+			move(cell.logicalOuter);
+			move(cell.textRect);
+			move(cell.logicalTextRect);
+		}
+	}
+	for (auto &button : block->buttons) {
+		move(button.rect);
+		move(button.labelRect);
+		move(button.iconRect);
+		move(button.logicalRect);
+		move(button.logicalLabelRect);
+		move(button.logicalIconRect);
+	}
+	for (auto &child : block->children) {
+		ShiftLaidOutBlock(&child, shift);
+	}
+}
+
+[[nodiscard]] std::optional<int> RecountBlocksInWindow(
+		const std::vector<PreparedBlock> &prepared,
+		const std::vector<PreparedFormulaSlot> &formulas,
+		std::vector<LaidOutBlock> *blocks,
+		LaidOutBlocksWindow window,
+		bool widthChanged,
+		const style::Markdown &st,
+		int left,
+		int top,
+		int width,
+		LayoutContext context) {
+	if (!blocks || prepared.size() != blocks->size()) {
+		return std::nullopt;
+	}
+	auto y = top;
+	auto previous = static_cast<const PreparedBlock*>(nullptr);
+	for (auto i = 0, count = int(prepared.size()); i != count; ++i) {
+		const auto &preparedBlock = prepared[i];
+		auto &live = (*blocks)[i];
+		const auto anchorOnly = IsAnchorOnlyBlock(preparedBlock);
+		auto blockContext = context;
+		blockContext.preparedPath.push_back(i);
+		if (HideEmptyQuoteAuthorBlock(preparedBlock, blockContext)) {
+			live = HiddenQuoteAuthorBlock(preparedBlock);
+			continue;
+		}
+		if (previous && !anchorOnly) {
+			y += BlockSkip(*previous, preparedBlock, context, st);
+		}
+
+		// The window is tested against the geometry before this pass, so
+		// blocks around the previously visible range get the precise layout.
+		const auto near = anchorOnly
+			|| ((live.outer.y() < window.bottom)
+				&& (BlockBottom(live) >= window.top));
+		if (near && (live.estimated || widthChanged)) {
+			const auto analysis = AnalyzeRetainedBlockAt(
+				prepared,
+				*blocks,
+				i,
 				formulas,
-				&live,
 				st,
-				left + st.relatedArticle.headerPadding.left(),
-				y + st.relatedArticle.headerPadding.top(),
-				std::max(
-					width
-						- st.relatedArticle.headerPadding.left()
-						- st.relatedArticle.headerPadding.right(),
-					1),
-				std::max(
-					logicalWidth
-						- st.relatedArticle.headerPadding.left()
-						- st.relatedArticle.headerPadding.right(),
-					1),
-				false,
-				blockContext)
-			: RecountBlockInPlace(
-				preparedBlock,
+				width,
+				context);
+			if (!analysis) {
+				return std::nullopt;
+			}
+			const auto bottom = RecountBlockAt(
+				prepared,
 				formulas,
 				&live,
-				analysis[i],
-				activeScrollOwner,
+				i,
+				*analysis,
+				nullptr,
 				st,
-				band.x(),
-				y,
-				band.width(),
-				logicalBandWidth,
-				blockContext);
-		if (!bottom) {
-			return std::nullopt;
-		}
-		if (IsRelatedArticlesHeader(preparedBlock, next)) {
-			live.headerRect = QRect(
 				left,
 				y,
-				std::max(width, 1),
-				live.outer.height()
-					+ st.relatedArticle.headerPadding.top()
-					+ st.relatedArticle.headerPadding.bottom());
-			live.outer = live.headerRect;
-			live.contentRect = live.headerRect;
-			RefreshLogicalGeometry(&live);
+				width,
+				width,
+				context);
+			if (!bottom) {
+				return std::nullopt;
+			}
+			live.estimated = false;
+			y = *bottom;
+		} else {
+			const auto height = live.outer.height();
+			ShiftLaidOutBlock(&live, y - live.outer.y());
+			live.estimated = live.estimated || widthChanged;
+			y += height;
 		}
-		y = BlockBottom(live);
 		if (!anchorOnly) {
 			previous = &preparedBlock;
 		}
@@ -4256,6 +4474,34 @@ std::optional<int> RecountLaidOutBlocks(
 		context);
 }
 
+std::optional<int> RecountLaidOutBlocksInWindow(
+		const std::vector<PreparedBlock> &prepared,
+		const std::vector<PreparedFormulaSlot> &formulas,
+		std::vector<LaidOutBlock> *blocks,
+		LaidOutBlocksWindow window,
+		bool widthChanged,
+		const style::Markdown &st,
+		int left,
+		int top,
+		int width,
+		LayoutContext context) {
+	return RecountBlocksInWindow(
+		prepared,
+		formulas,
+		blocks,
+		window,
+		widthChanged,
+		st,
+		left,
+		top,
+		width,
+		context);
+}
+
+int CountEstimatedBlocks(const std::vector<LaidOutBlock> &blocks) {
+	return int(ranges::count(blocks, true, &LaidOutBlock::estimated));
+}
+
 int ArticleContentMaxRight(
 		const std::vector<LaidOutBlock> &blocks,
 		const style::Markdown &st,
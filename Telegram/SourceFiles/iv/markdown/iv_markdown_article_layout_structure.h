@@ -11,6 +11,11 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace Iv::Markdown {
 
+struct LaidOutBlocksWindow {
+	int top = 0;
+	int bottom = 0;
+};
+
 [[nodiscard]] int LayoutBlocks(
 	const std::vector<PreparedBlock> &prepared,
 	std::vector<PreparedFormulaSlot> *formulas,
@@ -33,6 +38,22 @@ namespace Iv::Markdown {
 	int top,
 	int width,
 	LayoutContext context);
+// Top-level blocks intersecting the window (in the geometry before the call)
+// are laid out precisely at the new width, the rest keep their previous
+// height as an estimate, are only moved and get marked as estimated.
+[[nodiscard]] std::optional<int> RecountLaidOutBlocksInWindow(
+	const std::vector<PreparedBlock> &prepared,
+	const std::vector<PreparedFormulaSlot> &formulas,
+	std::vector<LaidOutBlock> *blocks,
+	LaidOutBlocksWindow window,
+	bool widthChanged,
+	const style::Markdown &st,
+	int left,
+	int top,
+	int width,
+	LayoutContext context);
+[[nodiscard]] int CountEstimatedBlocks(
+	const std::vector<LaidOutBlock> &blocks);
 [[nodiscard]] int ArticleContentMaxRight(
 	const std::vector<LaidOutBlock> &blocks,
 	const style::Markdown &st,
@@ -372,6 +372,9 @@ void MarkdownPreviewRoot::setup() {
 				}
 			});
 		}
+		_body->setLayoutShiftCallback([=](int shift) {
+			_scroll->scrollToY(_scroll->scrollTop() + shift);
+		});
 		_body->heightValue(
 		) | rpl::on_next([=](int) {
 			updateChildrenGeometry(size());
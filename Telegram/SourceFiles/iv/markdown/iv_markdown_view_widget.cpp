@@ -188,6 +188,11 @@ void MarkdownDocumentWidget::setZoomStepCallback(
 	_zoomStepCallback = std::move(callback);
 }
 
+void MarkdownDocumentWidget::setLayoutShiftCallback(
+		std::function<void(int)> callback) {
+	_layoutShiftCallback = std::move(callback);
+}
+
 void MarkdownDocumentWidget::setClickHandlerContext(
 		QVariant context,
 		std::shared_ptr<QVariant> contextRef) {
@@ -519,6 +524,7 @@ void MarkdownDocumentWidget::visibleTopBottomUpdated(
 		.bottom = visibleBottom,
 	};
 	syncArticleVisibleTopBottom();
+	scheduleEstimatedLayoutRefine();
 }
 
 void MarkdownDocumentWidget::keyPressEvent(QKeyEvent *e) {
@@ -1080,6 +1086,39 @@ void MarkdownDocumentWidget::syncArticleVisibleTopBottom() {
 	_article->setVisibleTopBottom(band.top, band.bottom);
 }
 
+void MarkdownDocumentWidget::scheduleEstimatedLayoutRefine() {
+	if (_estimatedLayoutRefineScheduled
+		|| !_article
+		|| !_article->hasEstimatedLayout()) {
+		return;
+	}
+	_estimatedLayoutRefineScheduled = true;
+	crl::on_main(this, [=] {
+		_estimatedLayoutRefineScheduled = false;
+		refineEstimatedLayout();
+	});
+}
+
+void MarkdownDocumentWidget::refineEstimatedLayout() {
+	if (!_article) {
+		return;
+	}
+	const auto refined = _article->refineEstimatedLayout();
+	if (!refined) {
+		return;
+	}
+	const auto scale = zoomScale();
+	const auto newHeight = std::max(int(std::ceil(refined->height * scale)), 1);
+	if (height() != newHeight) {
+		resize(width(), newHeight);
+	}
+	if (refined->visibleShift && _layoutShiftCallback) {
+		_layoutShiftCallback(int(std::round(refined->visibleShift * scale)));
+	}
+	update();
+	updateHoverAtCursor();
+}
+
 int MarkdownDocumentWidget::relayoutCurrentWidth(bool clearSelection) {
 	if (clearSelection) {
 		this->clearSelection();
@@ -53,6 +53,7 @@ public:
 	void setMediaActivationCallback(
 		std::function<bool(const MediaActivation &, Qt::MouseButton)> callback);
 	void setZoomStepCallback(std::function<void(int)> callback);
+	void setLayoutShiftCallback(std::function<void(int)> callback);
 	void setClickHandlerContext(
 		QVariant context,
 		std::shared_ptr<QVariant> contextRef = nullptr);
@@ -136,6 +137,8 @@ private:
 
 	[[nodiscard]] Ui::VisibleRange articleVisibleBand() const;
 	void syncArticleVisibleTopBottom();
+	void scheduleEstimatedLayoutRefine();
+	void refineEstimatedLayout();
 	int relayoutCurrentWidth(bool clearSelection);
 	void forceRelayoutCurrentWidth();
 	void scheduleFormattedDateRefresh();
@@ -177,6 +180,7 @@ private:
 	std::function<void(const PreparedLink &, Qt::MouseButton)> _activateLink;
 	std::function<bool(const MediaActivation &, Qt::MouseButton)> _activateMedia;
 	std::function<void(int)> _zoomStepCallback;
+	std::function<void(int)> _layoutShiftCallback;
 	QVariant _clickHandlerContext;
 	std::shared_ptr<QVariant> _clickHandlerContextRef;
 	MarkdownArticleSelection _selection;
@@ -210,6 +214,7 @@ private:
 	bool _activeHorizontalScrollDrag = false;
 	bool _articlePainted = false;
 	bool _mediaCreationRetried = false;
+	bool _estimatedLayoutRefineScheduled = false;
 	bool _activeTouchHorizontalScroll = false;
 	std::optional<QPoint> _pendingTouchHorizontalScrollPoint;
 
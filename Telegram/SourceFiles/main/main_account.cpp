@@ -86,6 +86,11 @@ void Account::start(std::unique_ptr<MTP::Config> config) {
 	watchSessionChanges();
 }
 
+void Account::preloadStorage(
+		std::shared_ptr<MTP::AuthKey> localKey) {
+	_local->prepareMap(std::move(localKey));
+}
+
 void Account::prepareToStartAdded(
 		std::shared_ptr<MTP::AuthKey> localKey) {
 	_local->startAdded(std::move(localKey));
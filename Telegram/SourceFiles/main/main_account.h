@@ -44,6 +44,8 @@ public:
 		const QByteArray &passcode);
 	[[nodiscard]] std::unique_ptr<MTP::Config> prepareToStart(
 		std::shared_ptr<MTP::AuthKey> localKey);
+	void preloadStorage(
+		std::shared_ptr<MTP::AuthKey> localKey);
 	void prepareToStartAdded(
 		std::shared_ptr<MTP::AuthKey> localKey);
 	void start(std::unique_ptr<MTP::Config> config);
@@ -238,6 +238,7 @@ constexpr auto kFadeDuration = crl::time(500);
 constexpr auto kCheckPlaybackPositionTimeout = crl::time(100); // 100ms per check audio position
 constexpr auto kCheckPlaybackPositionDelta = 2400LL; // update position called each 2400 samples
 constexpr auto kCheckFadingTimeout = crl::time(7); // 7ms
+constexpr auto kWakeupsStatsPeriod = 60 * crl::time(1000);
 
 rpl::event_stream<AudioMsgId> UpdatedStream;
 
@@ -395,14 +396,19 @@ int Mixer::Track::getNotQueuedBufferIndex() {
 				const auto samplesInBuffer = withSpeed.samples[i];
 				withSpeed.bufferedPosition += samplesInBuffer;
 				withSpeed.bufferedLength -= samplesInBuffer;
+
+				// Keep the memory, the loader will fill it once again.
+				auto unqueued = std::move(withSpeed.buffered[i]);
 				for (auto j = i + 1; j != kBuffersCount; ++j) {
 					withSpeed.samples[j - 1] = withSpeed.samples[j];
 					stream.buffers[j - 1] = stream.buffers[j];
-					withSpeed.buffered[j - 1] = withSpeed.buffered[j];
+					withSpeed.buffered[j - 1] = std::move(
+						withSpeed.buffered[j]);
 				}
+				unqueued.resize(0);
 				withSpeed.samples[kBuffersCount - 1] = 0;
 				stream.buffers[kBuffersCount - 1] = buffer;
-				withSpeed.buffered[kBuffersCount - 1] = QByteArray();
+				withSpeed.buffered[kBuffersCount - 1] = std::move(unqueued);
 				found = true;
 				break;
 			}
@@ -1099,6 +1105,12 @@ void Fader::onInit() {
 }
 
 void Fader::onTimer() {
+	auto busy = QElapsedTimer();
+	busy.start();
+	const auto guard = gsl::finally([&] {
+		countWakeup(busy.nsecsElapsed());
+	});
+
 	QMutexLocker lock(&AudioMutex);
 	if (!mixer()) return;
 
@@ -1177,6 +1189,25 @@ void Fader::onTimer() {
 	}
 }
 
+void Fader::countWakeup(qint64 busyNs) {
+	++_wakeups;
+	_wakeupsBusyNs += busyNs;
+	if (!_wakeupsTimer.isValid()) {
+		_wakeupsTimer.start();
+		return;
+	}
+	const auto elapsed = _wakeupsTimer.elapsed();
+	if (elapsed < kWakeupsStatsPeriod) {
+		return;
+	}
+	DEBUG_LOG(("Audio Fader: %1 wakeups per second, busy %2% of the time."
+		).arg(_wakeups * 1000. / elapsed, 0, 'f', 1
+		).arg(_wakeupsBusyNs / (elapsed * 10000.), 0, 'f', 4));
+	_wakeups = 0;
+	_wakeupsBusyNs = 0;
+	_wakeupsTimer.start();
+}
+
 int32 Fader::updateOnePlayback(Mixer::Track *track, bool &hasPlaying, bool &hasFading, float64 volumeMultiplier, bool volumeChanged) {
 	const auto errorHappened = [&] {
 		if (Audio::PlaybackErrorHappened()) {
@@ -13,6 +13,7 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 #include "base/bytes.h"
 #include "base/timer.h"
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QTimer>
 
 namespace Ui {
@@ -353,9 +354,14 @@ private:
 	};
 	int32 updateOnePlayback(Mixer::Track *track, bool &hasPlaying, bool &hasFading, float64 volumeMultiplier, bool volumeChanged);
 	void setStoppedState(Mixer::Track *track, State state = State::Stopped);
+	void countWakeup(qint64 busyNs);
 
 	QTimer _timer;
 
+	QElapsedTimer _wakeupsTimer;
+	qint64 _wakeupsBusyNs = 0;
+	int _wakeups = 0;
+
 	bool _volumeChangedSong = false;
 	bool _volumeChangedVideo = false;
 
@@ -174,13 +174,16 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 	auto waiting = false;
 	auto errAtStart = started;
 
-	auto accumulated = QByteArray();
+	// Reuse the memory of the buffer that was replaced the last time.
+	auto accumulated = base::take(_samplesPool);
+	accumulated.resize(0);
 	auto accumulatedCount = 0;
 	if (l->holdsSavedDecodedSamples()) {
 		l->takeSavedDecodedSamples(&accumulated);
 		accumulatedCount = accumulated.size() / sampleSize;
 	}
 	const auto accumulateTill = l->bytesPerBuffer();
+	accumulated.reserve(accumulateTill);
 	while (accumulated.size() < accumulateTill) {
 		using Error = AudioPlayerLoader::ReadError;
 		const auto result = l->readMore();
@@ -284,15 +287,17 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 		}
 		track->waitingForBuffer = false;
 
-		track->withSpeed.buffered[bufferIndex] = accumulated;
+		auto &buffered = track->withSpeed.buffered[bufferIndex];
+		std::swap(buffered, accumulated);
 		track->withSpeed.samples[bufferIndex] = accumulatedCount;
 		track->withSpeed.bufferedLength += accumulatedCount;
 		alBufferData(
 			track->stream.buffers[bufferIndex],
 			track->format,
-			accumulated.constData(),
-			accumulated.size(),
+			buffered.constData(),
+			buffered.size(),
 			track->state.frequency);
+		_samplesPool = std::move(accumulated);
 
 		alSourceQueueBuffers(
 			track->stream.source,
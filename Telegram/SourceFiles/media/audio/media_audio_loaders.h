@@ -67,6 +67,7 @@ private:
 	std::unique_ptr<AudioPlayerLoader> _audioLoader;
 	std::unique_ptr<AudioPlayerLoader> _songLoader;
 	std::unique_ptr<AudioPlayerLoader> _videoLoader;
+	QByteArray _samplesPool;
 
 	QMutex _fromExternalMutex;
 	base::flat_map<
@@ -199,6 +199,9 @@ public:
 
 private:
 	[[nodiscard]] bool receiveInto(not_null<AVFrame*> frame);
+	[[nodiscard]] QImage takeKeyframe(crl::time position);
+	[[nodiscard]] QImage takeExact(crl::time position);
+	void setKeyframesOnly(bool only);
 	void seekTo(crl::time position);
 
 	Source &_source;
@@ -208,6 +211,9 @@ private:
 	SwscalePointer _scale;
 	AVPacket *_packet = nullptr;
 	crl::time _decodedPosition = -1;
+	crl::time _keyframePosition = -1;
+	QImage _keyframe;
+	bool _keyframesOnly = false;
 	bool _finished = false;
 
 };
@@ -230,6 +236,23 @@ bool Extractor::valid() const {
 	return _frame && _kept && _packet && _source.codec;
 }
 
+void Extractor::setKeyframesOnly(bool only) {
+	if (_keyframesOnly == only) {
+		return;
+	}
+	_keyframesOnly = only;
+
+	// The decoder is flushed on each seek, so switching is safe there.
+	const auto context = _source.codec.get();
+	context->skip_frame = only ? AVDISCARD_NONKEY : AVDISCARD_DEFAULT;
+	context->skip_loop_filter = only ? AVDISCARD_ALL : AVDISCARD_DEFAULT;
+	if (only) {
+		context->flags2 |= AV_CODEC_FLAG2_FAST;
+	} else {
+		context->flags2 &= ~AV_CODEC_FLAG2_FAST;
+	}
+}
+
 void Extractor::seekTo(crl::time position) {
 	const auto stream = _source.videoStream;
 	const auto target = TimeToPts(
@@ -294,7 +317,48 @@ bool Extractor::receiveInto(not_null<AVFrame*> frame) {
 	}
 }
 
+QImage Extractor::takeKeyframe(crl::time position) {
+	setKeyframesOnly(true);
+	seekTo(position);
+	if (!receiveInto(_frame.get())) {
+		return {};
+	}
+	const auto at = FramePosition(
+		_frame.get(),
+		_source.videoStream->time_base);
+	const auto unref = gsl::finally([&] {
+		av_frame_unref(_frame.get());
+	});
+	if (at < 0 || position - at > _request.keyframeTolerance) {
+		// Short and long GOP clips have few keyframes, so many positions
+		// would get the same one. Those are decoded exactly instead.
+		return {};
+	} else if (at == _keyframePosition && !_keyframe.isNull()) {
+		return _keyframe;
+	} else if (!FrameHasData(_frame.get())) {
+		return {};
+	}
+	_keyframePosition = at;
+	_keyframe = ConvertFrame(
+		_frame.get(),
+		_source.rotation,
+		_request.box,
+		_request.cover,
+		_scale);
+	return _keyframe;
+}
+
 QImage Extractor::take(crl::time position) {
+	if (_request.keyframeTolerance > 0) {
+		if (auto result = takeKeyframe(position); !result.isNull()) {
+			return result;
+		}
+		setKeyframesOnly(false);
+	}
+	return takeExact(position);
+}
+
+QImage Extractor::takeExact(crl::time position) {
 	const auto timeBase = _source.videoStream->time_base;
 	const auto behind = (_decodedPosition < 0)
 		|| (position < _decodedPosition);
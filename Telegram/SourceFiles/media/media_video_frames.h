@@ -26,6 +26,10 @@ struct ExtractRequest {
 	std::vector<crl::time> positions;
 	QSize box;
 	bool cover = false;
+
+	// Take the keyframe preceding a position if it is not further than
+	// that from it, decoding keyframes only. The exact frame otherwise.
+	crl::time keyframeTolerance = 0;
 };
 
 using ExtractCallback = Fn<bool(int index, QImage &&frame)>;
@@ -78,7 +78,6 @@ constexpr auto kSiblingUserpicSize = 0.3;
 constexpr auto kInnerHeightMultiplier = 1.6;
 constexpr auto kPreloadPeersCount = 3;
 constexpr auto kPreloadStoriesCount = 5;
-constexpr auto kPreloadNextMediaCount = 3;
 constexpr auto kPreloadPreviousMediaCount = 1;
 constexpr auto kMarkAsReadAfterSeconds = 0.2;
 constexpr auto kMarkAsReadAfterProgress = 0.;
@@ -828,19 +827,28 @@ void Controller::rebuildFromContext(
 void Controller::preloadNext() {
 	Expects(shown());
 
-	auto ids = std::vector<FullStoryId>();
-	ids.reserve(kPreloadPreviousMediaCount + kPreloadNextMediaCount);
 	const auto peer = shownPeer();
+	auto &stories = peer->owner().stories();
+	const auto plan = stories.viewerPreload();
+	auto ids = std::vector<FullStoryId>();
+	ids.reserve(plan.next + kPreloadPreviousMediaCount + 1);
 	const auto count = shownCount();
-	const auto till = std::min(_index + kPreloadNextMediaCount, count);
-	for (auto i = _index + 1; i != till; ++i) {
+	const auto till = std::min(_index + 1 + plan.next, count);
+	for (auto i = _index + 1; i < till; ++i) {
 		ids.push_back({ .peer = peer->id, .story = shownId(i) });
 	}
+	if (plan.nextSource || till == count) {
+		if (const auto right = _siblingRight.get()) {
+			if (const auto id = right->shownId()) {
+				ids.push_back(id);
+			}
+		}
+	}
 	const auto from = std::max(_index - kPreloadPreviousMediaCount, 0);
 	for (auto i = _index; i != from;) {
 		ids.push_back({ .peer = peer->id, .story = shownId(--i) });
 	}
-	peer->owner().stories().setPreloadingInViewer(std::move(ids));
+	stories.setPreloadingInViewer(std::move(ids));
 }
 
 void Controller::checkMoveByDelta() {
@@ -989,14 +997,19 @@ bool Controller::changeShown(Data::Story *story) {
 	}
 	if (_shown) {
 		Assert(_session != nullptr);
-		_session->data().stories().unregisterPolling(
-			_shown,
-			Data::Stories::Polling::Viewer);
+		auto &stories = _session->data().stories();
+		stories.unregisterPolling(_shown, Data::Stories::Polling::Viewer);
+		if (id && !sessionChanged) {
+			stories.viewerStoryLeft(
+				crl::now() - _shownAt,
+				(id.peer != _shown.peer));
+		}
 	}
 	if (sessionChanged) {
 		_sessionLifetime.destroy();
 	}
 	_shown = id;
+	_shownAt = crl::now();
 	_session = session;
 	if (sessionChanged) {
 		subscribeToSession();
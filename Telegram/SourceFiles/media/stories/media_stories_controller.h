@@ -331,6 +331,7 @@ private:
 	bool _paused = false;
 
 	FullStoryId _shown;
+	crl::time _shownAt = 0;
 	TextWithEntities _captionText;
 	Data::StoriesContext _context;
 	std::optional<Data::StoriesSource> _source;
@@ -190,6 +190,7 @@ using RecognitionCacheMap = base::flat_map<RecognitionId, RecognitionResult>;
 }
 
 constexpr auto kPreloadCount = 3;
+constexpr auto kPreparedPhotosLimit = 96 * 1024 * 1024;
 constexpr auto kMaxZoomLevel = 7; // x8
 constexpr auto kZoomToScreenLevel = 1024;
 constexpr auto kPinchZoomStep = 0.25;
@@ -6198,6 +6199,23 @@ void OverlayWidget::validatePhotoImage(Image *image, bool blurred) {
 	_blurred = blurred;
 }
 
+void OverlayWidget::validatePreparedPhoto() {
+	if (!_staticContent.isNull() && !_blurred) {
+		return;
+	}
+	const auto i = _preparedPhotos.find(_photo);
+	if (i == end(_preparedPhotos) || i->second.image.isNull()) {
+		return;
+	}
+	const auto use = flipSizeByRotation({ _width, _height })
+		* style::DevicePixelRatio();
+	if (i->second.size == use) {
+		setStaticContent(std::move(i->second.image));
+		_blurred = false;
+	}
+	_preparedPhotos.erase(i);
+}
+
 void OverlayWidget::validatePhotoCurrentImage() {
 	if (!_photo) {
 		return;
@@ -6214,6 +6232,7 @@ void OverlayWidget::validatePhotoCurrentImage() {
 			});
 		}
 	}
+	validatePreparedPhoto();
 	validatePhotoImage(_photoMedia->image(Data::PhotoSize::Large), false);
 	validatePhotoImage(_photoMedia->image(Data::PhotoSize::Thumbnail), true);
 	validatePhotoImage(_photoMedia->image(Data::PhotoSize::Small), true);
@@ -7814,6 +7833,7 @@ void OverlayWidget::setSession(not_null<Main::Session*> session) {
 		if (!isHidden()) {
 			updateControls();
 			checkForSaveLoaded();
+			preparePreloadedPhotos();
 		}
 	}, _sessionLifetime);
 
@@ -7919,14 +7939,24 @@ void OverlayWidget::preloadData(int delta) {
 	auto till = *_index + (delta ? delta * kPreloadCount : 1);
 	if (from > till) std::swap(from, till);
 
+	if (delta && (delta > 0) != (_preloadDirection > 0)) {
+		// Decoding of the photos we went away from is not needed anymore.
+		clearPreparedPhotos();
+	}
+	if (delta) {
+		_preloadDirection = delta;
+	}
+
 	auto photos = base::flat_set<std::shared_ptr<Data::PhotoMedia>>();
 	auto documents = base::flat_set<std::shared_ptr<Data::DocumentMedia>>();
+	auto order = std::vector<std::pair<int, std::shared_ptr<Data::PhotoMedia>>>();
 	for (auto index = from; index != till + 1; ++index) {
 		auto entity = entityByIndex(index);
 		if (auto photo = std::get_if<not_null<PhotoData*>>(&entity.data)) {
 			const auto &[i, ok] = photos.emplace((*photo)->createMediaView());
 			(*i)->wanted(Data::PhotoSize::Small, fileOrigin(entity));
 			(*photo)->load(fileOrigin(entity), LoadFromCloudOrLocal, true);
+			order.emplace_back(std::abs(index - *_index), *i);
 		} else if (auto document = std::get_if<not_null<DocumentData*>>(
 				&entity.data)) {
 			const auto &[i, ok] = documents.emplace(
@@ -7939,6 +7969,75 @@ void OverlayWidget::preloadData(int delta) {
 	}
 	_preloadPhotos = std::move(photos);
 	_preloadDocuments = std::move(documents);
+
+	ranges::stable_sort(order, ranges::less(), [](const auto &pair) {
+		return pair.first;
+	});
+	_preloadPhotosOrder = order | ranges::views::values | ranges::to_vector;
+	preparePreloadedPhotos();
+}
+
+void OverlayWidget::preparePreloadedPhotos() {
+	if (!_preparedPhotosCanceled) {
+		_preparedPhotosCanceled = std::make_shared<std::atomic<bool>>();
+	}
+	const auto canceled = _preparedPhotosCanceled;
+	const auto ratio = style::DevicePixelRatio();
+	const auto weak = base::make_weak(_widget);
+
+	// Nearest photos first, the farther ones don't fit into the limit.
+	auto prepared = base::flat_map<not_null<PhotoData*>, PreparedPhoto>();
+	auto bytes = int64();
+	for (const auto &media : _preloadPhotosOrder) {
+		const auto photo = media->owner();
+		if (photo == _photo || photo->videoCanBePlayed()) {
+			continue;
+		}
+		const auto size = style::ConvertScale(
+			QSize(photo->width(), photo->height())) * ratio;
+		if (size.isEmpty()) {
+			continue;
+		}
+		bytes += int64(size.width()) * size.height() * 4;
+		if (bytes > kPreparedPhotosLimit) {
+			break;
+		}
+		const auto i = _preparedPhotos.find(photo);
+		if (i != end(_preparedPhotos) && i->second.size == size) {
+			prepared.emplace(photo, std::move(i->second));
+			continue;
+		}
+		const auto image = media->image(Data::PhotoSize::Large);
+		if (!image || image->isNull()) {
+			continue;
+		}
+		prepared.emplace(photo, PreparedPhoto{ .size = size });
+		crl::async([=, original = image->original()] {
+			if (canceled->load()) {
+				return;
+			}
+			auto result = Images::Prepare(original, size, {});
+			crl::on_main(weak, [=, result = std::move(result)]() mutable {
+				if (canceled->load()) {
+					return;
+				}
+				const auto i = _preparedPhotos.find(photo);
+				if (i != end(_preparedPhotos)
+					&& i->second.size == size
+					&& i->second.image.isNull()) {
+					i->second.image = std::move(result);
+				}
+			});
+		});
+	}
+	_preparedPhotos = std::move(prepared);
+}
+
+void OverlayWidget::clearPreparedPhotos() {
+	if (const auto canceled = base::take(_preparedPhotosCanceled)) {
+		canceled->store(true);
+	}
+	_preparedPhotos.clear();
 }
 
 void OverlayWidget::handleMousePress(
@@ -8824,6 +8923,9 @@ void OverlayWidget::clearBeforeHide() {
 	assignMediaPointer(nullptr);
 	_preloadPhotos.clear();
 	_preloadDocuments.clear();
+	_preloadPhotosOrder.clear();
+	_preloadDirection = 0;
+	clearPreparedPhotos();
 	if (_menu) {
 		_menu->hideMenu(true);
 	}
@@ -211,6 +211,10 @@ private:
 		const bool continueStreaming = false;
 		const crl::time startTime = 0;
 	};
+	struct PreparedPhoto {
+		QSize size;
+		QImage image;
+	};
 
 	[[nodiscard]] not_null<QWindow*> window() const;
 	[[nodiscard]] int width() const;
@@ -352,6 +356,8 @@ private:
 	void updateGeometryToScreen(bool inMove = false);
 	bool moveToNext(int delta);
 	void preloadData(int delta);
+	void preparePreloadedPhotos();
+	void clearPreparedPhotos();
 
 	void handleScreenChanged(not_null<QScreen*> screen);
 
@@ -583,6 +589,7 @@ private:
 	void initGroupThumbs();
 
 	void validatePhotoImage(Image *image, bool blurred);
+	void validatePreparedPhoto();
 	void validatePhotoCurrentImage();
 	void tryStartTextRecognition();
 
@@ -654,6 +661,10 @@ private:
 	std::shared_ptr<Data::PhotoMedia> _videoCoverMedia;
 	base::flat_set<std::shared_ptr<Data::PhotoMedia>> _preloadPhotos;
 	base::flat_set<std::shared_ptr<Data::DocumentMedia>> _preloadDocuments;
+	std::vector<std::shared_ptr<Data::PhotoMedia>> _preloadPhotosOrder;
+	base::flat_map<not_null<PhotoData*>, PreparedPhoto> _preparedPhotos;
+	std::shared_ptr<std::atomic<bool>> _preparedPhotosCanceled;
+	int _preloadDirection = 0;
 	int _rotation = 0;
 	std::unique_ptr<SharedMedia> _sharedMedia;
 	std::optional<SharedMediaWithLastSlice> _sharedMediaData;
@@ -462,6 +462,7 @@ void SetupExperimental(
 				MTP::details::kOptionPreferIPv6,
 				Core::kOptionSkipUrlSchemeRegister,
 				Core::kOptionDeadlockDetector,
+				Core::kOptionStallProfiler,
 				Webview::kOptionWebviewDebugEnabled,
 				Webview::kOptionWebviewLegacyEdge,
 			}
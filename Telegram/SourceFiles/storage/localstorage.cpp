@@ -12,8 +12,6 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 #include "storage/details/storage_file_utilities.h"
 #include "storage/details/storage_settings_scheme.h"
 #include "data/data_session.h"
-#include "data/data_document.h"
-#include "data/data_document_media.h"
 #include "base/platform/base_platform_info.h"
 #include "base/random.h"
 #include "ui/power_saving.h"
@@ -22,7 +20,6 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 #include "core/application.h"
 #include "core/core_settings.h"
 #include "core/version.h"
-#include "media/audio/media_audio.h"
 #include "mtproto/mtproto_config.h"
 #include "mtproto/mtproto_dc_options.h"
 #include "main/main_domain.h"
@@ -32,6 +29,7 @@ https://github.com/fagramdesktop/fadesktop/blob/dev/LEGAL
 #include "lang/lang_instance.h"
 
 #include <QtCore/QDirIterator>
+#include <xxhash.h>
 
 #ifndef Q_OS_WIN
 #include <unistd.h>
@@ -45,7 +43,6 @@ namespace Local {
 namespace {
 
 constexpr auto kThemeFileSizeLimit = 5 * 1024 * 1024;
-constexpr auto kFileLoaderQueueStopTimeout = crl::time(5000);
 
 constexpr auto kSavedBackgroundFormat = QImage::Format_ARGB32_Premultiplied;
 constexpr auto kWallPaperLegacySerializeTagId = int32(-111);
@@ -61,9 +58,8 @@ using Database = Storage::Cache::Database;
 
 QString _basePath, _userBasePath, _userDbPath;
 
-TaskQueue *_localLoader = nullptr;
-
 QByteArray _settingsSalt;
+uint64 _settingsWrittenHash = 0;
 
 auto OldKey = MTP::AuthKeyPtr();
 auto SettingsKey = MTP::AuthKeyPtr();
@@ -343,7 +339,6 @@ void sync() {
 }
 
 void finish() {
-	delete base::take(_localLoader);
 	Storage::details::Finish();
 }
 
@@ -354,11 +349,10 @@ void readLangPack();
 void start() {
 	Expects(_basePath.isEmpty());
 
-	_localLoader = new TaskQueue(kFileLoaderQueueStopTimeout);
-
 	_basePath = cWorkingDir() + u"tdata/"_q;
 	if (!QDir().exists(_basePath)) QDir().mkpath(_basePath);
 
+	const auto ms = crl::now();
 	ReadSettingsContext context;
 	FileReadDescriptor settingsData;
 	// We dropped old test authorizations when migrated to multi auth.
@@ -411,6 +405,7 @@ void start() {
 	_settingsSalt = salt;
 
 	applyReadContext(std::move(context));
+	LOG(("Settings read time: %1").arg(crl::now() - ms));
 	if (context.legacyRead) {
 		writeSettings();
 	}
@@ -445,17 +440,19 @@ void writeSettings() {
 	// We dropped old test authorizations when migrated to multi auth.
 	//const auto name = cTestMode() ? u"settings_test"_q : u"settings"_q;
 	const auto name = u"settings"_q;
-	FileWriteDescriptor settings(name, _basePath);
 	if (_settingsSalt.isEmpty() || !SettingsKey) {
 		_settingsSalt.resize(LocalEncryptSaltSize);
 		base::RandomFill(_settingsSalt.data(), _settingsSalt.size());
 		SettingsKey = CreateLegacyLocalKey(QByteArray(), _settingsSalt);
+		_settingsWrittenHash = 0;
 	}
-	settings.writeData(_settingsSalt);
 
 	if (!_settingsWriteAllowed) {
+		FileWriteDescriptor settings(name, _basePath);
+		settings.writeData(_settingsSalt);
 		EncryptedDescriptor data(0);
 		settings.writeEncrypted(data, SettingsKey);
+		_settingsWrittenHash = 0;
 		return;
 	}
 	const auto configSerialized = LookupFallbackConfig().serialize();
@@ -511,6 +508,15 @@ void writeSettings() {
 		data.stream << quint32(dbiLanguagesKey) << quint64(_languagesKey);
 	}
 
+	// Most of the saves are requested without any actual changes.
+	const auto hash = XXH64(data.data.constData(), data.data.size(), 0);
+	if (hash == _settingsWrittenHash) {
+		return;
+	}
+	_settingsWrittenHash = hash;
+
+	FileWriteDescriptor settings(name, _basePath);
+	settings.writeData(_settingsSalt);
 	settings.writeEncrypted(data, SettingsKey);
 }
 
@@ -779,10 +785,6 @@ void moveLegacyBackground(
 }
 
 void reset() {
-	if (_localLoader) {
-		_localLoader->stop();
-	}
-
 	Window::Theme::Background()->reset();
 	_oldSettingsVersion = 0;
 	Core::App().settings().resetOnLastLogout();
@@ -793,76 +795,6 @@ int32 oldSettingsVersion() {
 	return _oldSettingsVersion;
 }
 
-class CountWaveformTask : public Task {
-public:
-	CountWaveformTask(not_null<Data::DocumentMedia*> media)
-	: _doc(media->owner())
-	, _loc(_doc->location(true))
-	, _data(media->bytes())
-	, _wavemax(0) {
-		if (_data.isEmpty() && !_loc.accessEnable()) {
-			_doc = nullptr;
-		}
-	}
-	void process() override {
-		if (!_doc) return;
-
-		_waveform = audioCountWaveform(_loc, _data);
-		_wavemax = _waveform.empty()
-			? char(0)
-			: *ranges::max_element(_waveform);
-	}
-	void finish() override {
-		if (const auto voice = _doc ? _doc->voice() : nullptr) {
-			if (!_waveform.isEmpty()) {
-				voice->waveform = _waveform;
-				voice->wavemax = _wavemax;
-			}
-			if (voice->waveform.isEmpty()) {
-				voice->waveform.resize(1);
-				voice->waveform[0] = -2;
-				voice->wavemax = 0;
-			} else if (voice->waveform[0] < 0) {
-				voice->waveform[0] = -2;
-				voice->wavemax = 0;
-			}
-			_doc->owner().requestDocumentViewRepaint(_doc);
-		}
-	}
-	~CountWaveformTask() {
-		if (_data.isEmpty() && _doc) {
-			_loc.accessDisable();
-		}
-	}
-
-protected:
-	DocumentData *_doc = nullptr;
-	Core::FileLocation _loc;
-	QByteArray _data;
-	VoiceWaveform _waveform;
-	char _wavemax;
-
-};
-
-void countVoiceWaveform(not_null<Data::DocumentMedia*> media) {
-	const auto document = media->owner();
-	if (const auto voice = document->voice()) {
-		if (_localLoader) {
-			voice->waveform.resize(1 + sizeof(TaskId));
-			voice->waveform[0] = -1; // counting
-			TaskId taskId = _localLoader->addTask(
-				std::make_unique<CountWaveformTask>(media));
-			memcpy(voice->waveform.data() + 1, &taskId, sizeof(taskId));
-		}
-	}
-}
-
-void cancelTask(TaskId id) {
-	if (_localLoader) {
-		_localLoader->cancelTask(id);
-	}
-}
-
 Window::Theme::Saved readThemeUsingKey(FileKey key) {
 	using namespace Window::Theme;
 
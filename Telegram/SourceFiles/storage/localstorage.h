@@ -16,7 +16,6 @@ class History;
 
 namespace Data {
 class WallPaper;
-class DocumentMedia;
 } // namespace Data
 
 namespace Lang {
@@ -70,10 +69,6 @@ void reset();
 
 int32 oldSettingsVersion();
 
-void countVoiceWaveform(not_null<Data::DocumentMedia*> media);
-
-void cancelTask(TaskId id);
-
 void writeTheme(const Window::Theme::Saved &saved);
 void clearTheme();
 [[nodiscard]] Window::Theme::Saved readThemeAfterSwitch();
@@ -304,38 +304,36 @@ base::flat_set<QString> Account::collectGoodNames() const {
 	return result;
 }
 
-Account::ReadMapResult Account::readMapWith(
+Account::MapData Account::readMapData(
 		MTP::AuthKeyPtr localKey,
-		const QByteArray &legacyPasscode) {
-	auto ms = crl::now();
-
+		const QByteArray &legacyPasscode) const {
 	FileReadDescriptor mapData;
 	if (!ReadFile(mapData, u"map"_q, _basePath)) {
-		return ReadMapResult::Failed;
+		return { .result = ReadMapResult::Failed };
 	}
 	LOG(("App Info: reading map..."));
 
 	QByteArray legacySalt, legacyKeyEncrypted, mapEncrypted;
 	mapData.stream >> legacySalt >> legacyKeyEncrypted >> mapEncrypted;
 	if (!CheckStreamStatus(mapData.stream)) {
-		return ReadMapResult::Failed;
+		return { .result = ReadMapResult::Failed };
 	}
 	if (!localKey) {
 		if (legacySalt.size() != LocalEncryptSaltSize) {
 			LOG(("App Error: bad salt in map file, size: %1").arg(legacySalt.size()));
-			return ReadMapResult::Failed;
+			return { .result = ReadMapResult::Failed };
 		}
 		auto legacyPasscodeKey = CreateLegacyLocalKey(legacyPasscode, legacySalt);
 
 		EncryptedDescriptor keyData;
 		if (!DecryptLocal(keyData, legacyKeyEncrypted, legacyPasscodeKey)) {
 			LOG(("App Info: could not decrypt pass-protected key from map file, maybe bad password..."));
-			return ReadMapResult::IncorrectPasscode;
+			return { .result = ReadMapResult::IncorrectPasscode };
 		}
 		auto key = Serialize::read<MTP::AuthKey::Data>(keyData.stream);
 		if (keyData.stream.status() != QDataStream::Ok || !keyData.stream.atEnd()) {
 			LOG(("App Error: could not read pass-protected key from map file"));
-			return ReadMapResult::Failed;
+			return { .result = ReadMapResult::Failed };
 		}
 		localKey = std::make_shared<MTP::AuthKey>(key);
 	}
@@ -343,29 +341,14 @@ Account::ReadMapResult Account::readMapWith(
 	EncryptedDescriptor map;
 	if (!DecryptLocal(map, mapEncrypted, localKey)) {
 		LOG(("App Error: could not decrypt map."));
-		return ReadMapResult::Failed;
+		return { .result = ReadMapResult::Failed };
 	}
 	LOG(("App Info: reading encrypted map..."));
 
-	QByteArray selfSerialized;
-	base::flat_map<PeerId, FileKey> draftsMap;
-	base::flat_map<PeerId, FileKey> draftCursorsMap;
-	base::flat_map<PeerId, bool> draftsNotReadMap;
-	base::flat_map<PeerId, FileKey> botStoragesMap;
-	base::flat_map<PeerId, bool> botStoragesNotReadMap;
-	quint64 prefsKey = 0, locationsKey = 0, reportSpamStatusesKey = 0, trustedPeersKey = 0;
-	quint64 recentStickersKeyOld = 0;
-	quint64 installedStickersKey = 0, featuredStickersKey = 0, recentStickersKey = 0, favedStickersKey = 0, archivedStickersKey = 0;
-	quint64 installedMasksKey = 0, recentMasksKey = 0, archivedMasksKey = 0;
-	quint64 installedCustomEmojiKey = 0, featuredCustomEmojiKey = 0, archivedCustomEmojiKey = 0;
-	quint64 savedGifsKey = 0;
-	quint64 legacyBackgroundKeyDay = 0, legacyBackgroundKeyNight = 0;
-	quint64 userSettingsKey = 0, recentHashtagsAndBotsKey = 0, exportSettingsKey = 0;
-	quint64 searchSuggestionsKey = 0;
-	quint64 roundPlaceholderKey = 0;
-	quint64 inlineBotsDownloadsKey = 0;
-	quint64 mediaLastPlaybackPositionsKey = 0;
-	QByteArray webviewStorageTokenBots, webviewStorageTokenOther;
+	auto result = MapData{
+		.result = ReadMapResult::Success,
+		.version = mapData.version,
+	};
 	while (!map.stream.atEnd()) {
 		quint32 keyType;
 		map.stream >> keyType;
@@ -378,12 +361,12 @@ Account::ReadMapResult Account::readMapWith(
 				quint64 peerIdSerialized;
 				map.stream >> key >> peerIdSerialized;
 				const auto peerId = DeserializePeerId(peerIdSerialized);
-				draftsMap.emplace(peerId, key);
-				draftsNotReadMap.emplace(peerId, true);
+				result.draftsMap.emplace(peerId, key);
+				result.draftsNotReadMap.emplace(peerId, true);
 			}
 		} break;
 		case lskSelfSerialized: {
-			map.stream >> selfSerialized;
+			map.stream >> result.selfSerialized;
 		} break;
 		case lskDraftPosition: {
 			quint32 count = 0;
@@ -393,7 +376,7 @@ Account::ReadMapResult Account::readMapWith(
 				quint64 peerIdSerialized;
 				map.stream >> key >> peerIdSerialized;
 				const auto peerId = DeserializePeerId(peerIdSerialized);
-				draftCursorsMap.emplace(peerId, key);
+				result.draftCursorsMap.emplace(peerId, key);
 			}
 		} break;
 		case lskLegacyImages:
@@ -410,86 +393,91 @@ Account::ReadMapResult Account::readMapWith(
 			}
 		} break;
 		case lskPrefs: {
-			map.stream >> prefsKey;
+			map.stream >> result.prefsKey;
 		} break;
 		case lskLocations: {
-			map.stream >> locationsKey;
+			map.stream >> result.locationsKey;
 		} break;
 		case lskReportSpamStatusesOld: {
-			map.stream >> reportSpamStatusesKey;
-			ClearKey(reportSpamStatusesKey, _basePath);
+			quint64 key;
+			map.stream >> key;
+			ClearKey(key, _basePath);
 		} break;
 		case lskTrustedPeers: {
-			map.stream >> trustedPeersKey;
+			map.stream >> result.trustedPeersKey;
 		} break;
 		case lskRecentStickersOld: {
-			map.stream >> recentStickersKeyOld;
+			map.stream >> result.recentStickersKeyOld;
 		} break;
 		case lskBackgroundOldOld: {
-			map.stream >> (Window::Theme::IsNightMode()
-				? legacyBackgroundKeyNight
-				: legacyBackgroundKeyDay);
+			map.stream >> result.legacyBackgroundKey;
 		} break;
 		case lskBackgroundOld: {
-			map.stream >> legacyBackgroundKeyDay >> legacyBackgroundKeyNight;
+			map.stream
+				>> result.legacyBackgroundKeyDay
+				>> result.legacyBackgroundKeyNight;
 		} break;
 		case lskUserSettings: {
-			map.stream >> userSettingsKey;
+			map.stream >> result.userSettingsKey;
 		} break;
 		case lskRecentHashtagsAndBots: {
-			map.stream >> recentHashtagsAndBotsKey;
+			map.stream >> result.recentHashtagsAndBotsKey;
 		} break;
 		case lskStickersOld: {
-			map.stream >> installedStickersKey;
+			map.stream >> result.installedStickersKey;
 		} break;
 		case lskStickersKeys: {
-			map.stream >> installedStickersKey >> featuredStickersKey >> recentStickersKey >> archivedStickersKey;
+			map.stream
+				>> result.installedStickersKey
+				>> result.featuredStickersKey
+				>> result.recentStickersKey
+				>> result.archivedStickersKey;
 		} break;
 		case lskFavedStickers: {
-			map.stream >> favedStickersKey;
+			map.stream >> result.favedStickersKey;
 		} break;
 		case lskSavedGifsOld: {
 			quint64 key;
 			map.stream >> key;
 		} break;
 		case lskSavedGifs: {
-			map.stream >> savedGifsKey;
+			map.stream >> result.savedGifsKey;
 		} break;
 		case lskSavedPeersOld: {
 			quint64 key;
 			map.stream >> key;
 		} break;
 		case lskExportSettings: {
-			map.stream >> exportSettingsKey;
+			map.stream >> result.exportSettingsKey;
 		} break;
 		case lskMasksKeys: {
 			map.stream
-				>> installedMasksKey
-				>> recentMasksKey
-				>> archivedMasksKey;
+				>> result.installedMasksKey
+				>> result.recentMasksKey
+				>> result.archivedMasksKey;
 		} break;
 		case lskCustomEmojiKeys: {
 			map.stream
-				>> installedCustomEmojiKey
-				>> featuredCustomEmojiKey
-				>> archivedCustomEmojiKey;
+				>> result.installedCustomEmojiKey
+				>> result.featuredCustomEmojiKey
+				>> result.archivedCustomEmojiKey;
 		} break;
 		case lskSearchSuggestions: {
-			map.stream >> searchSuggestionsKey;
+			map.stream >> result.searchSuggestionsKey;
 		} break;
 		case lskRoundPlaceholder: {
-			map.stream >> roundPlaceholderKey;
+			map.stream >> result.roundPlaceholderKey;
 		} break;
 		case lskInlineBotsDownloads: {
-			map.stream >> inlineBotsDownloadsKey;
+			map.stream >> result.inlineBotsDownloadsKey;
 		} break;
 		case lskMediaLastPlaybackPositions: {
-			map.stream >> mediaLastPlaybackPositionsKey;
+			map.stream >> result.mediaLastPlaybackPositionsKey;
 		} break;
 		case lskWebviewTokens: {
 			map.stream
-				>> webviewStorageTokenBots
-				>> webviewStorageTokenOther;
+				>> result.webviewStorageTokenBots
+				>> result.webviewStorageTokenOther;
 		} break;
 		case lskBotStorages: {
 			quint32 count = 0;
@@ -499,55 +487,83 @@ Account::ReadMapResult Account::readMapWith(
 				quint64 peerIdSerialized;
 				map.stream >> key >> peerIdSerialized;
 				const auto peerId = DeserializePeerId(peerIdSerialized);
-				botStoragesMap.emplace(peerId, key);
-				botStoragesNotReadMap.emplace(peerId, true);
+				result.botStoragesMap.emplace(peerId, key);
+				result.botStoragesNotReadMap.emplace(peerId, true);
 			}
 		} break;
 		default:
 			LOG(("App Error: unknown key type in encrypted map: %1").arg(keyType));
-			return ReadMapResult::Failed;
+			return { .result = ReadMapResult::Failed };
 		}
 		if (!CheckStreamStatus(map.stream)) {
-			return ReadMapResult::Failed;
+			return { .result = ReadMapResult::Failed };
 		}
 	}
 
-	_localKey = std::move(localKey);
+	result.localKey = std::move(localKey);
+	return result;
+}
+
+void Account::prepareMap(MTP::AuthKeyPtr localKey) {
+	Expects(localKey != nullptr);
+	Expects(!_preparedMap.has_value());
+
+	_preparedMap = readMapData(std::move(localKey));
+}
+
+Account::ReadMapResult Account::readMapWith(
+		MTP::AuthKeyPtr localKey,
+		const QByteArray &legacyPasscode) {
+	auto ms = crl::now();
 
-	_draftsMap = draftsMap;
-	_draftCursorsMap = draftCursorsMap;
-	_draftsNotReadMap = draftsNotReadMap;
-	_botStoragesMap = botStoragesMap;
-	_botStoragesNotReadMap = botStoragesNotReadMap;
-
-	_prefsKey = prefsKey;
-	_locationsKey = locationsKey;
-	_trustedPeersKey = trustedPeersKey;
-	_recentStickersKeyOld = recentStickersKeyOld;
-	_installedStickersKey = installedStickersKey;
-	_featuredStickersKey = featuredStickersKey;
-	_recentStickersKey = recentStickersKey;
-	_favedStickersKey = favedStickersKey;
-	_archivedStickersKey = archivedStickersKey;
-	_savedGifsKey = savedGifsKey;
-	_installedMasksKey = installedMasksKey;
-	_recentMasksKey = recentMasksKey;
-	_archivedMasksKey = archivedMasksKey;
-	_installedCustomEmojiKey = installedCustomEmojiKey;
-	_featuredCustomEmojiKey = featuredCustomEmojiKey;
-	_archivedCustomEmojiKey = archivedCustomEmojiKey;
-	_legacyBackgroundKeyDay = legacyBackgroundKeyDay;
-	_legacyBackgroundKeyNight = legacyBackgroundKeyNight;
-	_settingsKey = userSettingsKey;
-	_recentHashtagsAndBotsKey = recentHashtagsAndBotsKey;
-	_exportSettingsKey = exportSettingsKey;
-	_searchSuggestionsKey = searchSuggestionsKey;
-	_roundPlaceholderKey = roundPlaceholderKey;
-	_inlineBotsDownloadsKey = inlineBotsDownloadsKey;
-	_mediaLastPlaybackPositionsKey = mediaLastPlaybackPositionsKey;
-	_oldMapVersion = mapData.version;
-	_webviewStorageIdBots.token = webviewStorageTokenBots;
-	_webviewStorageIdOther.token = webviewStorageTokenOther;
+	auto data = _preparedMap
+		? *base::take(_preparedMap)
+		: readMapData(std::move(localKey), legacyPasscode);
+	if (data.result != ReadMapResult::Success) {
+		return data.result;
+	}
+	if (data.legacyBackgroundKey) {
+		(Window::Theme::IsNightMode()
+			? data.legacyBackgroundKeyNight
+			: data.legacyBackgroundKeyDay) = data.legacyBackgroundKey;
+	}
+
+	_localKey = std::move(data.localKey);
+
+	_draftsMap = std::move(data.draftsMap);
+	_draftCursorsMap = std::move(data.draftCursorsMap);
+	_draftsNotReadMap = std::move(data.draftsNotReadMap);
+	_botStoragesMap = std::move(data.botStoragesMap);
+	_botStoragesNotReadMap = std::move(data.botStoragesNotReadMap);
+
+	_prefsKey = data.prefsKey;
+	_locationsKey = data.locationsKey;
+	_trustedPeersKey = data.trustedPeersKey;
+	_recentStickersKeyOld = data.recentStickersKeyOld;
+	_installedStickersKey = data.installedStickersKey;
+	_featuredStickersKey = data.featuredStickersKey;
+	_recentStickersKey = data.recentStickersKey;
+	_favedStickersKey = data.favedStickersKey;
+	_archivedStickersKey = data.archivedStickersKey;
+	_savedGifsKey = data.savedGifsKey;
+	_installedMasksKey = data.installedMasksKey;
+	_recentMasksKey = data.recentMasksKey;
+	_archivedMasksKey = data.archivedMasksKey;
+	_installedCustomEmojiKey = data.installedCustomEmojiKey;
+	_featuredCustomEmojiKey = data.featuredCustomEmojiKey;
+	_archivedCustomEmojiKey = data.archivedCustomEmojiKey;
+	_legacyBackgroundKeyDay = data.legacyBackgroundKeyDay;
+	_legacyBackgroundKeyNight = data.legacyBackgroundKeyNight;
+	_settingsKey = data.userSettingsKey;
+	_recentHashtagsAndBotsKey = data.recentHashtagsAndBotsKey;
+	_exportSettingsKey = data.exportSettingsKey;
+	_searchSuggestionsKey = data.searchSuggestionsKey;
+	_roundPlaceholderKey = data.roundPlaceholderKey;
+	_inlineBotsDownloadsKey = data.inlineBotsDownloadsKey;
+	_mediaLastPlaybackPositionsKey = data.mediaLastPlaybackPositionsKey;
+	_oldMapVersion = data.version;
+	_webviewStorageIdBots.token = data.webviewStorageTokenBots;
+	_webviewStorageIdOther.token = data.webviewStorageTokenOther;
 
 	if (_oldMapVersion < AppVersion) {
 		writeMapDelayed();
@@ -572,10 +588,10 @@ Account::ReadMapResult Account::readMapWith(
 	auto stored = readSessionSettings();
 	readMtpData();
 
-	DEBUG_LOG(("selfSerialized set: %1").arg(selfSerialized.size()));
+	DEBUG_LOG(("selfSerialized set: %1").arg(data.selfSerialized.size()));
 	_owner->setSessionFromStorage(
 		std::move(stored),
-		std::move(selfSerialized),
+		std::move(data.selfSerialized),
 		_oldMapVersion);
 
 	LOG(("Map read time: %1").arg(crl::now() - ms));
@@ -72,6 +72,10 @@ public:
 	[[nodiscard]] std::unique_ptr<MTP::Config> start(
 		MTP::AuthKeyPtr localKey);
 	void startAdded(MTP::AuthKeyPtr localKey);
+
+	// Reads and decrypts the map ahead of start(), may be called from
+	// any thread while nothing else uses this account yet.
+	void prepareMap(MTP::AuthKeyPtr localKey);
 	[[nodiscard]] int oldMapVersion() const {
 		return _oldMapVersion;
 	}
@@ -227,6 +231,45 @@ private:
 		IncorrectPasscode,
 		Failed,
 	};
+	struct MapData {
+		ReadMapResult result = ReadMapResult::Failed;
+		MTP::AuthKeyPtr localKey;
+		int version = 0;
+		QByteArray selfSerialized;
+		base::flat_map<PeerId, FileKey> draftsMap;
+		base::flat_map<PeerId, FileKey> draftCursorsMap;
+		base::flat_map<PeerId, bool> draftsNotReadMap;
+		base::flat_map<PeerId, FileKey> botStoragesMap;
+		base::flat_map<PeerId, bool> botStoragesNotReadMap;
+		FileKey prefsKey = 0;
+		FileKey locationsKey = 0;
+		FileKey trustedPeersKey = 0;
+		FileKey recentStickersKeyOld = 0;
+		FileKey installedStickersKey = 0;
+		FileKey featuredStickersKey = 0;
+		FileKey recentStickersKey = 0;
+		FileKey favedStickersKey = 0;
+		FileKey archivedStickersKey = 0;
+		FileKey installedMasksKey = 0;
+		FileKey recentMasksKey = 0;
+		FileKey archivedMasksKey = 0;
+		FileKey installedCustomEmojiKey = 0;
+		FileKey featuredCustomEmojiKey = 0;
+		FileKey archivedCustomEmojiKey = 0;
+		FileKey savedGifsKey = 0;
+		FileKey legacyBackgroundKey = 0;
+		FileKey legacyBackgroundKeyDay = 0;
+		FileKey legacyBackgroundKeyNight = 0;
+		FileKey userSettingsKey = 0;
+		FileKey recentHashtagsAndBotsKey = 0;
+		FileKey exportSettingsKey = 0;
+		FileKey searchSuggestionsKey = 0;
+		FileKey roundPlaceholderKey = 0;
+		FileKey inlineBotsDownloadsKey = 0;
+		FileKey mediaLastPlaybackPositionsKey = 0;
+		QByteArray webviewStorageTokenBots;
+		QByteArray webviewStorageTokenOther;
+	};
 	enum class PeerTrustFlag : uchar {
 		NoOpenGame        = (1 << 0),
 		Payment           = (1 << 1),
@@ -238,6 +281,9 @@ private:
 	[[nodiscard]] auto prepareReadSettingsContext() const
 		-> details::ReadSettingsContext;
 
+	[[nodiscard]] MapData readMapData(
+		MTP::AuthKeyPtr localKey,
+		const QByteArray &legacyPasscode = QByteArray()) const;
 	ReadMapResult readMapWith(
 		MTP::AuthKeyPtr localKey,
 		const QByteArray &legacyPasscode = QByteArray());
@@ -382,6 +428,7 @@ private:
 	base::flat_map<QByteArray, QByteArray> _prefs;
 
 	int _oldMapVersion = 0;
+	std::optional<MapData> _preparedMap;
 
 	base::Timer _writeMapTimer;
 	base::Timer _writePrefsTimer;
@@ -169,42 +169,102 @@ Domain::StartModernResult Domain::startModern(
 	_oldVersion = keyData.version;
 
 	auto tried = base::flat_set<int>();
-	auto sessions = base::flat_set<uint64>();
-	auto active = 0;
+	auto indices = std::vector<int>();
 	for (auto i = 0; i != count; ++i) {
 		auto index = qint32();
 		info.stream >> index;
 		if (index >= 0
 			&& index < Main::Domain::kPremiumMaxAccounts
 			&& tried.emplace(index).second) {
-			auto account = std::make_unique<Main::Account>(
-				_owner,
-				_dataName,
-				index);
-			auto config = account->prepareToStart(_localKey);
-			const auto sessionId = account->willHaveSessionUniqueId(
-				config.get());
-			if (!sessions.contains(sessionId)
-				&& (sessionId != 0 || (sessions.empty() && i + 1 == count))) {
-				if (sessions.empty()) {
-					active = index;
-				}
-				account->start(std::move(config));
-				_owner->accountAddedInStorage({
-					.index = index,
-					.account = std::move(account)
-				});
-				sessions.emplace(sessionId);
+			indices.push_back(index);
+		}
+	}
+	auto stored = std::optional<int>();
+	if (!info.stream.atEnd()) {
+		auto index = qint32();
+		info.stream >> index;
+		stored = index;
+	}
+	const auto activePosition = [&] {
+		const auto i = stored
+			? ranges::find(indices, *stored)
+			: end(indices);
+		return (i != end(indices)) ? int(i - begin(indices)) : 0;
+	}();
+
+	// Inactive accounts read and decrypt their maps on worker threads
+	// while the map of the active one is read on the main thread first.
+	// The rest, the settings and the session, are read and all accounts
+	// are started on the main thread in their stored order.
+	const auto started = crl::now();
+	const auto indicesCount = int(indices.size());
+	auto accounts = std::vector<std::unique_ptr<Main::Account>>();
+	accounts.reserve(indicesCount);
+	for (const auto index : indices) {
+		accounts.push_back(std::make_unique<Main::Account>(
+			_owner,
+			_dataName,
+			index));
+	}
+	const auto preloaded = std::make_unique<crl::semaphore[]>(indicesCount);
+	for (auto i = 0; i != indicesCount; ++i) {
+		if (i == activePosition) {
+			preloaded[i].release();
+			continue;
+		}
+		const auto account = accounts[i].get();
+		const auto semaphore = &preloaded[i];
+		crl::async([=, localKey = _localKey] {
+			account->preloadStorage(localKey);
+			semaphore->release();
+		});
+	}
+	const auto prepare = [&](int i) {
+		preloaded[i].acquire();
+		auto result = accounts[i]->prepareToStart(_localKey);
+		LOG(("App Info: account %1 storage read at %2 ms."
+			).arg(indices[i]
+			).arg(crl::now() - started));
+		return result;
+	};
+	auto activeConfig = (activePosition < indicesCount)
+		? prepare(activePosition)
+		: nullptr;
+
+	auto sessions = base::flat_set<uint64>();
+	auto active = 0;
+	for (auto i = 0; i != indicesCount; ++i) {
+		const auto index = indices[i];
+		auto &account = accounts[i];
+		auto config = (i == activePosition)
+			? std::move(activeConfig)
+			: prepare(i);
+		const auto sessionId = account->willHaveSessionUniqueId(
+			config.get());
+		if (!sessions.contains(sessionId)
+			&& (sessionId != 0
+				|| (sessions.empty() && i + 1 == indicesCount))) {
+			if (sessions.empty()) {
+				active = index;
 			}
+			account->start(std::move(config));
+			_owner->accountAddedInStorage({
+				.index = index,
+				.account = std::move(account)
+			});
+			sessions.emplace(sessionId);
 		}
 	}
+	LOG(("App Info: %1 accounts storage started in %2 ms."
+		).arg(sessions.size()
+		).arg(crl::now() - started));
 	if (sessions.empty()) {
 		LOG(("App Error: no accounts read."));
 		return StartModernResult::Failed;
 	}
 
-	if (!info.stream.atEnd()) {
-		info.stream >> active;
+	if (stored) {
+		active = *stored;
 	}
 	_owner->activateFromStorage(active);
 
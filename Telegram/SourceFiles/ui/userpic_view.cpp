@@ -33,6 +33,178 @@ constexpr auto kCard2Radius = 0.16; // Tunable. Even less rounded.
 constexpr auto kCard2Opacity = 0.3; // Tunable.
 constexpr auto kGap = 0.02; // Tunable.
 
+constexpr auto kSharedCacheBudget = 24 * 1024 * 1024;
+constexpr auto kPrescaledLimit = 256;
+constexpr auto kPrescaleSizes = 3;
+
+struct SharedUserpicKey {
+	qint64 image = 0;
+	int size = 0;
+	int shape = 0;
+	int paletteVersion = 0;
+	int ratio = 0;
+	int roundness = 0;
+	int avatarShape = 0;
+	bool defaultRounding = false;
+
+	friend inline auto operator<=>(
+		const SharedUserpicKey &,
+		const SharedUserpicKey &) = default;
+	friend inline bool operator==(
+		const SharedUserpicKey &,
+		const SharedUserpicKey &) = default;
+};
+
+// Rounded cloud userpics shared by all the views that show the same
+// image with the same size and shape, in a memory budgeted LRU cache.
+class SharedUserpicCache final {
+public:
+	[[nodiscard]] QImage find(const SharedUserpicKey &key);
+	void insert(const SharedUserpicKey &key, QImage image);
+
+	[[nodiscard]] QImage takePrescaled(qint64 image, int size);
+	void prescaleInBackground(const QImage &cloud, int size);
+
+private:
+	struct Entry {
+		QImage image;
+		uint64 used = 0;
+	};
+
+	void storePrescaled(
+		qint64 image,
+		std::vector<std::pair<int, QImage>> scaled);
+	void dropOldestPrescaled();
+	void evict();
+
+	base::flat_map<SharedUserpicKey, Entry> _entries;
+	base::flat_map<std::pair<qint64, int>, Entry> _prescaled;
+	base::flat_set<qint64> _prescaleRequested;
+	std::vector<int> _recentSizes;
+	int64 _bytes = 0;
+	uint64 _counter = 0;
+
+};
+
+[[nodiscard]] SharedUserpicCache &SharedCache() {
+	static auto result = SharedUserpicCache();
+	return result;
+}
+
+[[nodiscard]] QImage ScaleCloudUserpic(const QImage &cloud, int size) {
+	return cloud.scaled(
+		QSize(size, size),
+		Qt::IgnoreAspectRatio,
+		Qt::SmoothTransformation);
+}
+
+QImage SharedUserpicCache::find(const SharedUserpicKey &key) {
+	const auto i = _entries.find(key);
+	if (i == end(_entries)) {
+		return QImage();
+	}
+	i->second.used = ++_counter;
+	return i->second.image;
+}
+
+void SharedUserpicCache::insert(const SharedUserpicKey &key, QImage image) {
+	_bytes += image.sizeInBytes();
+	auto &entry = _entries[key];
+	_bytes -= entry.image.sizeInBytes();
+	entry.image = std::move(image);
+	entry.used = ++_counter;
+	evict();
+}
+
+void SharedUserpicCache::dropOldestPrescaled() {
+	const auto i = ranges::min_element(
+		_prescaled,
+		ranges::less(),
+		[](const auto &pair) { return pair.second.used; });
+	_bytes -= i->second.image.sizeInBytes();
+	_prescaled.erase(i);
+}
+
+void SharedUserpicCache::evict() {
+	// Prescaled images are only a guess, so they are dropped first.
+	while (_bytes > kSharedCacheBudget && !_prescaled.empty()) {
+		dropOldestPrescaled();
+	}
+
+	// Evicted images stay alive in the views that still use them.
+	while (_bytes > kSharedCacheBudget && _entries.size() > 1) {
+		const auto i = ranges::min_element(
+			_entries,
+			ranges::less(),
+			[](const auto &pair) { return pair.second.used; });
+		_bytes -= i->second.image.sizeInBytes();
+		_entries.erase(i);
+	}
+}
+
+QImage SharedUserpicCache::takePrescaled(qint64 image, int size) {
+	const auto i = _prescaled.find(std::make_pair(image, size));
+	if (i == end(_prescaled)) {
+		return QImage();
+	}
+	auto result = std::move(i->second.image);
+	_bytes -= result.sizeInBytes();
+	_prescaled.erase(i);
+	return result;
+}
+
+void SharedUserpicCache::prescaleInBackground(const QImage &cloud, int size) {
+	const auto i = ranges::find(_recentSizes, size);
+	if (i != end(_recentSizes)) {
+		_recentSizes.erase(i);
+	}
+	_recentSizes.insert(begin(_recentSizes), size);
+	if (_recentSizes.size() > kPrescaleSizes + 1) {
+		_recentSizes.pop_back();
+	}
+
+	// The same image is likely to be shown soon in other places that use
+	// the sizes requested recently, prepare those while it is not needed.
+	const auto key = cloud.cacheKey();
+	if (_prescaleRequested.contains(key)) {
+		return;
+	} else if (_prescaleRequested.size() >= kPrescaledLimit) {
+		_prescaleRequested.clear();
+	}
+	_prescaleRequested.emplace(key);
+	auto sizes = _recentSizes;
+	sizes.erase(ranges::remove(sizes, size), end(sizes));
+	if (sizes.empty()) {
+		return;
+	}
+	crl::async([=, sizes = std::move(sizes)] {
+		auto scaled = std::vector<std::pair<int, QImage>>();
+		scaled.reserve(sizes.size());
+		for (const auto size : sizes) {
+			scaled.emplace_back(size, ScaleCloudUserpic(cloud, size));
+		}
+		crl::on_main([=, scaled = std::move(scaled)]() mutable {
+			SharedCache().storePrescaled(key, std::move(scaled));
+		});
+	});
+}
+
+void SharedUserpicCache::storePrescaled(
+		qint64 image,
+		std::vector<std::pair<int, QImage>> scaled) {
+	for (auto &[size, result] : scaled) {
+		_bytes += result.sizeInBytes();
+		auto &entry = _prescaled[std::make_pair(image, size)];
+		_bytes -= entry.image.sizeInBytes();
+		entry.image = std::move(result);
+		entry.used = ++_counter;
+	}
+	while (_prescaled.size() > kPrescaledLimit) {
+		dropOldestPrescaled();
+	}
+	evict();
+}
+
 } // namespace
 
 float64 ForumUserpicRadiusMultiplier() {
@@ -163,10 +335,26 @@ void ValidateUserpicCache(
 	const auto radius = size * FASettings::FASettings::getInstance().roundness() / 100 / style::DevicePixelRatio();
 
 	if (cloud) {
-		view.cached = cloud->scaled(
-			full,
-			Qt::IgnoreAspectRatio,
-			Qt::SmoothTransformation);
+		const auto key = SharedUserpicKey{
+			.image = cloud->cacheKey(),
+			.size = size,
+			.shape = int(shapeValue),
+			.paletteVersion = version,
+			.ratio = style::DevicePixelRatio(),
+			.roundness = FASettings::FASettings::getInstance().roundness(),
+			.avatarShape = FASettings::FASettings::getInstance().avatarShape(),
+			.defaultRounding = use_default_rounding,
+		};
+		auto &cache = SharedCache();
+		if (auto shared = cache.find(key); !shared.isNull()) {
+			view.cached = std::move(shared);
+			return;
+		}
+		view.cached = cache.takePrescaled(key.image, size);
+		if (view.cached.isNull()) {
+			view.cached = ScaleCloudUserpic(*cloud, size);
+		}
+		cache.prescaleInBackground(*cloud, size);
 		if (shape == PeerUserpicShape::Material) {
 			view.cached = FA::Ui::ApplyMaterialShape(std::move(view.cached));
 		} else if (shape == PeerUserpicShape::Monoforum) {
@@ -192,6 +380,7 @@ void ValidateUserpicCache(
 					Images::CornersMask(radius));
 			}
 		}
+		cache.insert(key, view.cached);
 	} else {
 		if (view.cached.size() != full) {
 			view.cached = QImage(full, QImage::Format_ARGB32_Premultiplied);
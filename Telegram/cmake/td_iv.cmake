@@ -45,6 +45,8 @@ PRIVATE
     iv/editor/iv_editor_page_media.h
     iv/editor/iv_editor_page_path.cpp
     iv/editor/iv_editor_page_path.h
+    iv/editor/iv_editor_page_snapshot.cpp
+    iv/editor/iv_editor_page_snapshot.h
     iv/editor/iv_editor_page_table_grid.cpp
     iv/editor/iv_editor_page_table_grid.h
     iv/editor/iv_editor_prepared_selection.cpp
@@ -72,6 +74,8 @@ PRIVATE
     iv/iv_search_bar.h
     iv/iv_search_controller.cpp
     iv/iv_search_controller.h
+    iv/iv_search_index.cpp
+    iv/iv_search_index.h
     iv/iv_zoom_controls.cpp
     iv/iv_zoom_controls.h
 )